@@ -0,0 +1,52 @@
+cmake_minimum_required(VERSION 3.5)
+
+#
+# Runs the game loop headless on a savegame and prints the performance report
+#
+
+if(NOT OPENTTD_EXECUTABLE)
+    message(FATAL_ERROR "Script needs OPENTTD_EXECUTABLE defined (tip: use -DOPENTTD_EXECUTABLE=..)")
+endif()
+if(NOT BENCHMARK_SAVEGAME)
+    message(FATAL_ERROR "Script needs BENCHMARK_SAVEGAME defined (tip: configure with -DBENCHMARK_SAVEGAME=..)")
+endif()
+if(NOT EXISTS ${BENCHMARK_SAVEGAME})
+    message(FATAL_ERROR "Benchmark savegame ${BENCHMARK_SAVEGAME} does not exist")
+endif()
+if(NOT BENCHMARK_TICKS)
+    set(BENCHMARK_TICKS 3000)
+endif()
+
+# If editbin is given, copy the executable to a new folder, and change the
+# subsystem to console, so the report ends up on the standard output.
+if(EDITBIN_EXECUTABLE)
+    execute_process(COMMAND ${CMAKE_COMMAND} -E copy ${OPENTTD_EXECUTABLE} benchmark.exe)
+    set(OPENTTD_EXECUTABLE "benchmark.exe")
+
+    execute_process(COMMAND ${EDITBIN_EXECUTABLE} /nologo /subsystem:console ${OPENTTD_EXECUTABLE})
+endif()
+
+# Run the benchmark; the savegame is loaded in the first tick, which is not
+# part of the game loop measurements.
+execute_process(COMMAND ${OPENTTD_EXECUTABLE}
+                        -x
+                        -c regression/regression.cfg
+                        -g ${BENCHMARK_SAVEGAME}
+                        -snull
+                        -mnull
+                        -vnull:ticks=${BENCHMARK_TICKS}:benchmark
+                        -Q
+                OUTPUT_VARIABLE BENCHMARK_OUTPUT
+                RESULT_VARIABLE BENCHMARK_RESULT
+                OUTPUT_STRIP_TRAILING_WHITESPACE
+)
+
+if(NOT BENCHMARK_RESULT EQUAL 0)
+    message(FATAL_ERROR "Benchmark failed with exit code ${BENCHMARK_RESULT}")
+endif()
+
+if(BENCHMARK_OUTPUT_FILE)
+    file(WRITE ${BENCHMARK_OUTPUT_FILE} "${BENCHMARK_OUTPUT}\n")
+endif()
+
+message("${BENCHMARK_OUTPUT}")
@@ -1391,6 +1391,7 @@ static void MaybeCrashAirplane(Aircraft *v)
 		ge.rating = 1;
 		ge.cargo.Truncate();
 	}
+	st->rating_cargoes = ALL_CARGOTYPES;
 
 	CrashAirplane(v);
 }
@@ -12,6 +12,7 @@
 #include "company_base.h"
 #include "debug.h"
 #include "industry.h"
+#include "landscape.h"
 #include "roadstop_base.h"
 #include "roadveh.h"
 #include "ship.h"
@@ -48,6 +49,13 @@ void CheckCaches()
 	RebuildTownCaches();
 	RebuildSubsidisedSourceAndDestinationCache();
 
+	/* Check that the tile loop only skips tiles on which it would not have done anything. */
+	for (TileIndex tile = 0; tile < Map::Size(); ++tile) {
+		if (IsTileLoopMarkedIdle(tile) && !IsTileLoopIdle(tile)) {
+			Debug(desync, 2, "warning: tile loop skipped while active: tile 0x{:x}", tile);
+		}
+	}
+
 	uint i = 0;
 	for (Town *t : Town::Iterate()) {
 		if (old_town_caches[i] != t->cache) {
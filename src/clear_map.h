@@ -96,6 +96,7 @@ inline void AddClearDensity(Tile t, int d)
 {
 	assert(IsTileType(t, MP_CLEAR)); // XXX incomplete
 	t.m5() += d;
+	MarkTileLoopActive(t);
 }
 
 /**
@@ -108,6 +109,7 @@ inline void SetClearDensity(Tile t, uint d)
 {
 	assert(IsTileType(t, MP_CLEAR));
 	SB(t.m5(), 0, 2, d);
+	MarkTileLoopActive(t);
 }
 
 
@@ -159,6 +161,7 @@ inline void SetClearGroundDensity(Tile t, ClearGround type, uint density)
 {
 	assert(IsTileType(t, MP_CLEAR)); // XXX incomplete
 	t.m5() = 0 << 5 | type << 2 | density;
+	MarkTileLoopActive(t);
 }
 
 
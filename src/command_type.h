@@ -363,6 +363,8 @@ enum Commands : uint16_t {
 	CMD_UPDATE_LEAGUE_TABLE_ELEMENT_SCORE, ///< update the score of a league table element
 	CMD_REMOVE_LEAGUE_TABLE_ELEMENT,       ///< remove a league table element
 
+	CMD_POSTPONE_LINK_GRAPH_JOIN,     ///< postpone or resume the join of the link graph jobs that are due
+
 	CMD_END,                          ///< Must ALWAYS be on the end of this list!! (period)
 };
 
@@ -49,6 +49,9 @@
 #include "goal_base.h"
 #include "story_base.h"
 #include "linkgraph/refresh.h"
+#include "pathfinder/yapf/yapf_cache.h"
+#include "pbs.h"
+#include "signal_func.h"
 #include "company_cmd.h"
 #include "economy_cmd.h"
 #include "vehicle_cmd.h"
@@ -494,6 +497,15 @@ void ChangeOwnershipOfCompanyItems(Owner old_owner, Owner new_owner)
 			ChangeTileOwner(tile, old_owner, new_owner);
 		} while (++tile != Map::Size());
 
+		/* Road vehicles cannot enter depots of other companies, so paths might have changed. */
+		YapfNotifyRoadLayoutChange(INVALID_TILE);
+		/* Rail segments end where the owner of the track changes. */
+		YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
+		/* Trains only follow reservations and signal blocks only extend over tracks of their own company. */
+		InvalidateReservationCache(INVALID_TILE);
+		InvalidateSignalSegments();
+		InvalidateTrainFreeRuns();
+
 		if (new_owner != INVALID_OWNER) {
 			/* Update all signals because there can be new segment that was owned by two companies
 			 * and signals were not propagated
@@ -1729,6 +1741,7 @@ static void LoadUnloadVehicle(Vehicle *front)
 					 * first unload to prevent the cargo from quickly decaying after the initial drop. */
 					ge->time_since_pickup = 0;
 					SetBit(ge->status, GoodsEntry::GES_RATING);
+					SetBit(st->rating_cargoes, v->cargo_type);
 				}
 			}
 
@@ -68,19 +68,26 @@ namespace {
 		/** Start time for current accumulation cycle */
 		TimingMeasurement acc_timestamp;
 
+		/** Sum of all durations recorded since the start of the process, unaffected by the circular buffer */
+		TimingMeasurement total_duration;
+		/** Number of cycles recorded since the start of the process */
+		uint64_t total_cycles;
+
 		/**
 		 * Initialize a data element with an expected collection rate
 		 * @param expected_rate
 		 * Expected number of cycles per second of the performance element. Use 1 if unknown or not relevant.
 		 * The rate is used for highlighting slow-running elements in the GUI.
 		 */
-		explicit PerformanceData(double expected_rate) : expected_rate(expected_rate), next_index(0), prev_index(0), num_valid(0) { }
+		explicit PerformanceData(double expected_rate) : expected_rate(expected_rate), next_index(0), prev_index(0), num_valid(0), total_duration(0), total_cycles(0) { }
 
 		/** Collect a complete measurement, given start and ending times for a processing block */
 		void Add(TimingMeasurement start_time, TimingMeasurement end_time)
 		{
 			this->durations[this->next_index] = end_time - start_time;
 			this->timestamps[this->next_index] = start_time;
+			this->total_duration += end_time - start_time;
+			this->total_cycles++;
 			this->prev_index = this->next_index;
 			this->next_index += 1;
 			if (this->next_index >= NUM_FRAMERATE_POINTS) this->next_index = 0;
@@ -99,12 +106,14 @@ namespace {
 
 			this->acc_duration = 0;
 			this->acc_timestamp = start_time;
+			this->total_cycles++;
 		}
 
 		/** Accumulate a period onto the current measurement */
 		void AddAccumulate(TimingMeasurement duration)
 		{
 			this->acc_duration += duration;
+			this->total_duration += duration;
 		}
 
 		/** Indicate a pause/expected discontinuity in processing the element */
@@ -1119,3 +1128,50 @@ void ProcessPendingPerformanceMeasurements()
 		_sound_perf_pending.store(false, std::memory_order_relaxed);
 	}
 }
+
+/**
+ * Write the totals of all performance measurements taken since the start of the process to stdout, as JSON.
+ * This is used by the null video driver in benchmark mode, so runs of the game loop can be compared between builds.
+ */
+void PrintPerformanceReport()
+{
+	static const std::array<std::string_view, PFE_AI0> MEASUREMENT_KEYS = {
+		"gameloop",
+		"gl_economy",
+		"gl_trains",
+		"gl_roadvehs",
+		"gl_ships",
+		"gl_aircraft",
+		"gl_landscape",
+		"gl_linkgraph",
+		"drawing",
+		"drawworld",
+		"video",
+		"sound",
+		"allscripts",
+		"gamescript",
+	};
+
+	const PerformanceData &gl = _pf_data[PFE_GAMELOOP];
+	double gl_seconds = (double)gl.total_duration / TIMESTAMP_PRECISION;
+
+	fmt::print("{{\n");
+	fmt::print("\t\"ticks\": {},\n", gl.total_cycles);
+	fmt::print("\t\"seconds\": {:.6f},\n", gl_seconds);
+	fmt::print("\t\"ticks_per_second\": {:.2f},\n", gl_seconds > 0 ? gl.total_cycles / gl_seconds : 0.0);
+	fmt::print("\t\"elements\": {{");
+
+	bool first = true;
+	for (PerformanceElement e = PFE_FIRST; e < PFE_MAX; e++) {
+		const PerformanceData &pf = _pf_data[e];
+		if (pf.total_cycles == 0) continue;
+
+		std::string key = e < PFE_AI0 ? std::string(MEASUREMENT_KEYS[e]) : fmt::format("ai{}", e - PFE_AI0);
+		double total_ms = (double)pf.total_duration * 1000 / TIMESTAMP_PRECISION;
+		fmt::print("{}\n\t\t\"{}\": {{ \"cycles\": {}, \"total_ms\": {:.3f}, \"average_ms\": {:.6f} }}",
+			first ? "" : ",", key, pf.total_cycles, total_ms, total_ms / pf.total_cycles);
+		first = false;
+	}
+
+	fmt::print("\n\t}}\n}}\n");
+}
@@ -18,7 +18,8 @@
  * Second is adding a member to the \link anonymous_namespace{framerate_gui.cpp}::_pf_data _pf_data \endlink array, in the same position as the new #PerformanceElement member.
  *
  * @par
- * Third is adding strings for the new element. There is an array in #ConPrintFramerate with strings used for the console command.
+ * Third is adding strings for the new element. There is an array in #ConPrintFramerate with strings used for the console command,
+ * and an array of JSON keys in #PrintPerformanceReport.
  * Additionally, there are two sets of strings in \c english.txt for two GUI uses, also in the #PerformanceElement order.
  * Search for \c STR_FRAMERATE_GAMELOOP and \c STR_FRAMETIME_CAPTION_GAMELOOP in \c english.txt to find those.
  *
@@ -122,5 +123,6 @@ public:
 
 void ShowFramerateWindow();
 void ProcessPendingPerformanceMeasurements();
+void PrintPerformanceReport();
 
 #endif /* FRAMERATE_TYPE_H */
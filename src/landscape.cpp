@@ -38,6 +38,10 @@
 #include "terraform_cmd.h"
 #include "station_func.h"
 #include "pathfinder/water_regions.h"
+#include "pathfinder/yapf/yapf_cache.h"
+#include "pbs.h"
+#include "signal_func.h"
+#include "train.h"
 
 #include "table/strings.h"
 #include "table/sprites.h"
@@ -533,11 +537,19 @@ void DoClearSquare(TileIndex tile)
 	if (_tile_type_procs[GetTileType(tile)]->animate_tile_proc != nullptr) DeleteAnimatedTile(tile);
 
 	bool remove = IsDockingTile(tile);
+	/* Only clearing track changes the signal blocks and free runs of trains; houses, trees and fields are cleared far more often. */
+	bool had_track = TrackStatusToTrackBits(GetTileTrackStatus(tile, TRANSPORT_RAIL, 0)) != TRACK_BIT_NONE;
 	MakeClear(tile, CLEAR_GRASS, _generating_world ? 3 : 0);
 	MarkTileDirtyByTile(tile);
 	if (remove) RemoveDockingTile(tile);
 
 	InvalidateWaterRegion(tile);
+	YapfNotifyRoadLayoutChange(tile);
+	InvalidateReservationCache(tile);
+	if (had_track) {
+		InvalidateSignalSegments(tile);
+		InvalidateTrainFreeRuns();
+	}
 }
 
 /**
@@ -761,8 +773,80 @@ std::tuple<CommandCost, Money> CmdClearArea(DoCommandFlag flags, TileIndex tile,
 
 TileIndex _cur_tileloop_tile;
 
+/**
+ * Tiles of which the tile loop is known to do nothing, until the tile or one of its neighbours is changed.
+ * @see IsTileLoopIdle
+ */
+static std::vector<bool> _tile_loop_idle;
+
+/** Mark all tiles of the just allocated map as needing their tile loop. */
+void AllocateTileLoopIdleMap()
+{
+	_tile_loop_idle.assign(Map::Size(), false);
+}
+
+/**
+ * Mark that the tile loop of a tile, and of the tiles next to it, has to be run again.
+ * This has to be called whenever a change to the tile might make one of these tile loops do something.
+ * @param tile The changed tile.
+ */
+void MarkTileLoopActive(TileIndex tile)
+{
+	if (_tile_loop_idle.empty()) return;
+
+	_tile_loop_idle[tile.base()] = false;
+	for (Direction dir = DIR_BEGIN; dir < DIR_END; dir++) {
+		TileIndex neighbour = tile + TileOffsByDir(dir);
+		if (neighbour < Map::Size()) _tile_loop_idle[neighbour.base()] = false;
+	}
+}
+
+/**
+ * Check whether the tile loop of a tile does nothing, and keeps doing nothing until the tile or one
+ * of its neighbours is changed, which calls #MarkTileLoopActive. That is the case for
+ * - water that is not coast and only has water next to it, as there is nothing to flood; and
+ * - clear land other than fields and growing grass in the temperate climate.
+ * Both play ambient sounds, which use random numbers, so nothing is idle when a NewGRF provides them.
+ * @param tile The tile to check.
+ * @return True iff the tile loop of \a tile has no effect.
+ */
+bool IsTileLoopIdle(TileIndex tile)
+{
+	switch (GetTileType(tile)) {
+		case MP_WATER:
+			if (IsCoast(tile)) return false;
+			for (Direction dir = DIR_BEGIN; dir < DIR_END; dir++) {
+				TileIndex dest = tile + TileOffsByDir(dir);
+				if (IsValidTile(dest) && !IsTileType(dest, MP_WATER)) return false;
+			}
+			return true;
+
+		case MP_CLEAR:
+			if (_settings_game.game_creation.landscape != LT_TEMPERATE) return false;
+			switch (GetClearGround(tile)) {
+				case CLEAR_GRASS: return GetClearDensity(tile) == 3;
+				case CLEAR_FIELDS: return false;
+				default: return true;
+			}
+
+		default:
+			return false;
+	}
+}
+
+/**
+ * Check whether a tile is marked as having an idle tile loop.
+ * @param tile The tile to check.
+ * @return True iff the tile loop of \a tile is skipped.
+ */
+bool IsTileLoopMarkedIdle(TileIndex tile)
+{
+	return !_tile_loop_idle.empty() && _tile_loop_idle[tile.base()];
+}
+
 /**
  * Gradually iterate over all tiles on the map, calling their TileLoopProcs once every TILE_UPDATE_FREQUENCY ticks.
+ * Tiles of which the tile loop is known to do nothing are skipped.
  */
 void RunTileLoop()
 {
@@ -794,14 +878,25 @@ void RunTileLoop()
 		count--;
 	}
 
+	/* Ambient sounds are played from otherwise idle tile loops, and consume random numbers. */
+	bool skip_idle = !HasGrfMiscBit(GMB_AMBIENT_SOUND_CALLBACK);
+
 	while (count--) {
-		_tile_type_procs[GetTileType(tile)]->tile_loop_proc(tile);
+		if (!skip_idle) {
+			_tile_type_procs[GetTileType(tile)]->tile_loop_proc(tile);
+		} else if (!_tile_loop_idle[tile.base()]) {
+			_tile_type_procs[GetTileType(tile)]->tile_loop_proc(tile);
+			if (IsTileLoopIdle(tile)) _tile_loop_idle[tile.base()] = true;
+		}
 
 		/* Get the next tile in sequence using a Galois LFSR. */
 		tile = (tile.base() >> 1) ^ (-(int32_t)(tile.base() & 1) & feedback);
 	}
 
 	_cur_tileloop_tile = tile;
+
+	/* Rebuild the water regions changed by flooding and construction before ships need them. */
+	UpdateDirtyWaterRegions();
 }
 
 void InitializeLandscape()
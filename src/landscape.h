@@ -133,6 +133,9 @@ bool HasFoundationNW(TileIndex tile, Slope slope_here, uint z_here);
 bool HasFoundationNE(TileIndex tile, Slope slope_here, uint z_here);
 
 void DoClearSquare(TileIndex tile);
+void AllocateTileLoopIdleMap();
+bool IsTileLoopIdle(TileIndex tile);
+bool IsTileLoopMarkedIdle(TileIndex tile);
 void RunTileLoop();
 
 void InitializeLandscape();
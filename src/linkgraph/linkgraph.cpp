@@ -54,9 +54,9 @@ void LinkGraph::ShiftDates(TimerGameEconomy::Date interval)
 {
 	this->last_compression += interval;
 	for (NodeID node1 = 0; node1 < this->Size(); ++node1) {
-		BaseNode &source = this->nodes[node1];
+		BaseNode &source = (*this)[node1];
 		if (source.last_update != EconomyTime::INVALID_DATE) source.last_update += interval;
-		for (BaseEdge &edge : this->nodes[node1].edges) {
+		for (BaseEdge &edge : source.edges) {
 			if (edge.last_unrestricted_update != EconomyTime::INVALID_DATE) edge.last_unrestricted_update += interval;
 			if (edge.last_restricted_update != EconomyTime::INVALID_DATE) edge.last_restricted_update += interval;
 		}
@@ -67,8 +67,9 @@ void LinkGraph::Compress()
 {
 	this->last_compression = (TimerGameEconomy::date + this->last_compression).base() / 2;
 	for (NodeID node1 = 0; node1 < this->Size(); ++node1) {
-		this->nodes[node1].supply /= 2;
-		for (BaseEdge &edge : this->nodes[node1].edges) {
+		BaseNode &source = (*this)[node1];
+		source.supply /= 2;
+		for (BaseEdge &edge : source.edges) {
 			if (edge.capacity > 0) {
 				uint new_capacity = std::max(1U, edge.capacity / 2);
 				if (edge.capacity < (1 << 16)) {
@@ -93,14 +94,16 @@ void LinkGraph::Merge(LinkGraph *other)
 	TimerGameEconomy::Date other_age = TimerGameEconomy::date - other->last_compression + 1;
 	NodeID first = this->Size();
 	for (NodeID node1 = 0; node1 < other->Size(); ++node1) {
-		Station *st = Station::Get(other->nodes[node1].station);
+		const BaseNode &source = std::as_const(*other)[node1];
+		Station *st = Station::Get(source.station);
 		NodeID new_node = this->AddNode(st);
-		this->nodes[new_node].supply = LinkGraph::Scale(other->nodes[node1].supply, age, other_age);
+		BaseNode &dest = (*this)[new_node];
+		dest.supply = LinkGraph::Scale(source.supply, age, other_age);
 		st->goods[this->cargo].link_graph = this->index;
 		st->goods[this->cargo].node = new_node;
 
-		for (BaseEdge &e : other->nodes[node1].edges) {
-			BaseEdge &new_edge = this->nodes[new_node].edges.emplace_back(first + e.dest_node);
+		for (const BaseEdge &e : source.edges) {
+			BaseEdge &new_edge = dest.edges.emplace_back(first + e.dest_node);
 			new_edge.capacity = LinkGraph::Scale(e.capacity, age, other_age);
 			new_edge.usage = LinkGraph::Scale(e.usage, age, other_age);
 			new_edge.travel_time_sum = LinkGraph::Scale(e.travel_time_sum, age, other_age);
@@ -118,12 +121,17 @@ void LinkGraph::RemoveNode(NodeID id)
 	assert(id < this->Size());
 
 	NodeID last_node = this->Size() - 1;
-	Station::Get(this->nodes[last_node].station)->goods[this->cargo].node = id;
+	Station::Get(this->nodes[last_node]->station)->goods[this->cargo].node = id;
 	/* Erase node by swapping with the last element. Node index is referenced
 	 * directly from station goods entries so the order and position must remain. */
 	this->nodes[id] = this->nodes.back();
 	this->nodes.pop_back();
-	for (auto &n : this->nodes) {
+	for (NodeID node = 0; node < this->Size(); ++node) {
+		/* Only nodes with edges to the removed or the moved node have to be modified. */
+		const BaseNode &shared = std::as_const(*this)[node];
+		if (!shared.HasEdgeTo(id) && (shared.edges.empty() || shared.edges.back().dest_node != last_node)) continue;
+
+		BaseNode &n = (*this)[node];
 		/* Find iterator position where an edge to id would be. */
 		auto [first, last] = std::equal_range(n.edges.begin(), n.edges.end(), id);
 		/* Remove potential node (erasing an empty range is safe). */
@@ -151,7 +159,7 @@ NodeID LinkGraph::AddNode(const Station *st)
 	const GoodsEntry &good = st->goods[this->cargo];
 
 	NodeID new_node = this->Size();
-	this->nodes.emplace_back(st->xy, st->index, HasBit(good.status, GoodsEntry::GES_ACCEPTANCE));
+	this->nodes.push_back(std::make_shared<BaseNode>(st->xy, st->index, HasBit(good.status, GoodsEntry::GES_ACCEPTANCE)));
 
 	return new_node;
 }
@@ -251,5 +259,6 @@ void LinkGraph::BaseEdge::Update(uint capacity, uint usage, uint32_t travel_time
 void LinkGraph::Init(uint size)
 {
 	assert(this->Size() == 0);
-	this->nodes.resize(size);
+	this->nodes.reserve(size);
+	for (uint i = 0; i < size; ++i) this->nodes.push_back(std::make_shared<BaseNode>());
 }
@@ -16,6 +16,7 @@
 #include "../timer/timer_game_economy.h"
 #include "../saveload/saveload.h"
 #include "linkgraph_type.h"
+#include <memory>
 #include <utility>
 
 class LinkGraph;
@@ -84,8 +85,9 @@ public:
 
 	/**
 	 * Node of the link graph. contains all relevant information from the associated
-	 * station. It's copied so that the link graph job can work on its own data set
-	 * in a separate thread.
+	 * station. It's shared with the link graph jobs running on the component and
+	 * copied when it's modified while shared, so that the link graph job can work
+	 * on its own data set in a separate thread.
 	 */
 	struct BaseNode {
 		uint supply;             ///< Supply at the station.
@@ -164,7 +166,7 @@ public:
 		}
 	};
 
-	typedef std::vector<BaseNode> NodeVector;
+	typedef std::vector<std::shared_ptr<BaseNode>> NodeVector;
 
 	/** Minimum effective distance for timeout calculation. */
 	static const uint MIN_TIMEOUT_DISTANCE = 32;
@@ -210,18 +212,24 @@ public:
 	 * trivial. */
 
 	/**
-	 * Get a node with the specified id.
+	 * Get a node with the specified id, in order to modify it. If the node is
+	 * still shared with a copy of the link graph, it is copied first.
 	 * @param num ID of the node.
 	 * @return the Requested node.
 	 */
-	inline BaseNode &operator[](NodeID num) { return this->nodes[num]; }
+	inline BaseNode &operator[](NodeID num)
+	{
+		std::shared_ptr<BaseNode> &node = this->nodes[num];
+		if (node.use_count() > 1) node = std::make_shared<BaseNode>(*node);
+		return *node;
+	}
 
 	/**
 	 * Get a const reference to a node with the specified id.
 	 * @param num ID of the node.
 	 * @return the Requested node.
 	 */
-	inline const BaseNode &operator[](NodeID num) const { return this->nodes[num]; }
+	inline const BaseNode &operator[](NodeID num) const { return *this->nodes[num]; }
 
 	/**
 	 * Get the current size of the component.
@@ -263,7 +271,7 @@ protected:
 
 	CargoID cargo;         ///< Cargo of this component's link graph.
 	TimerGameEconomy::Date last_compression; ///< Last time the capacities and supplies were compressed.
-	NodeVector nodes;      ///< Nodes in the component.
+	NodeVector nodes;      ///< Nodes in the component. Copying the link graph shares them, see operator[].
 };
 
 #endif /* LINKGRAPH_H */
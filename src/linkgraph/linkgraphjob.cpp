@@ -29,7 +29,8 @@ INSTANTIATE_POOL_METHODS(LinkGraphJob)
 /**
  * Create a link graph job from a link graph. The link graph will be copied so
  * that the calculations don't interfer with the normal operations on the
- * original. The job is immediately started.
+ * original. The copy shares the nodes with the original until the original
+ * modifies them, so this is cheap. The job is immediately started.
  * @param orig Original LinkGraph to be copied.
  */
 LinkGraphJob::LinkGraphJob(const LinkGraph &orig) :
@@ -120,12 +121,12 @@ LinkGraphJob::~LinkGraphJob()
 			continue;
 		}
 
-		LinkGraph *lg = LinkGraph::Get(ge.link_graph);
+		const LinkGraph *lg = LinkGraph::Get(ge.link_graph);
 		FlowStatMap &flows = from.flows;
 
 		for (const auto &edge : from.edges) {
 			if (edge.Flow() == 0) continue;
-			NodeID dest_id = edge.base.dest_node;
+			NodeID dest_id = edge.dest_node;
 			StationID to = this->nodes[dest_id].base.station;
 			Station *st2 = Station::GetIfValid(to);
 			if (st2 == nullptr || st2->goods[this->Cargo()].link_graph != this->link_graph.index ||
@@ -176,15 +177,27 @@ LinkGraphJob::~LinkGraphJob()
 
 /**
  * Initialize the link graph job: Resize nodes and edges and populate them.
+ * The edges and demands of all nodes are each stored in one block of memory,
+ * so the calculation can iterate them linearly.
  * This is done after the constructor so that we can do it in the calculation
  * thread without delaying the main game.
  */
 void LinkGraphJob::Init()
 {
 	uint size = this->Size();
+	size_t num_edges = 0;
+	for (NodeID i = 0; i < size; ++i) num_edges += this->link_graph[i].edges.size();
+
+	/* The nodes refer into these, so they must not be reallocated later on. */
+	this->edges.reserve(num_edges);
+	this->demands.resize(static_cast<size_t>(size) * size);
+
 	this->nodes.reserve(size);
-	for (uint i = 0; i < size; ++i) {
-		this->nodes.emplace_back(this->link_graph.nodes[i], this->link_graph.Size());
+	for (NodeID i = 0; i < size; ++i) {
+		const LinkGraph::BaseNode &node = this->link_graph[i];
+		size_t first = this->edges.size();
+		for (const LinkGraph::BaseEdge &e : node.edges) this->edges.emplace_back(e);
+		this->nodes.emplace_back(node, std::span(this->edges).subspan(first, node.edges.size()), std::span(this->demands).subspan(static_cast<size_t>(size) * i, size));
 	}
 }
 
@@ -223,7 +236,7 @@ uint Path::AddFlow(uint new_flow, LinkGraphJob &job, uint max_saturation)
 	if (this->parent != nullptr) {
 		LinkGraphJob::EdgeAnnotation &edge = job[this->parent->node][this->node];
 		if (max_saturation != UINT_MAX) {
-			uint usable_cap = edge.base.capacity * max_saturation / 100;
+			uint usable_cap = edge.capacity * max_saturation / 100;
 			if (usable_cap > edge.Flow()) {
 				new_flow = std::min(new_flow, usable_cap - edge.Flow());
 			} else {
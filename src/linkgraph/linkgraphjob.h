@@ -13,6 +13,7 @@
 #include "../thread.h"
 #include "linkgraph.h"
 #include <atomic>
+#include <span>
 
 class LinkGraphJob;
 class Path;
@@ -37,14 +38,18 @@ public:
 	};
 
 	/**
-	 * Annotation for a link graph edge.
+	 * Annotation for a link graph edge. Contains a copy of the data of the
+	 * annotated edge the calculation needs, so that the edges of all nodes can
+	 * be stored next to each other.
 	 */
 	struct EdgeAnnotation {
-		const LinkGraph::BaseEdge &base; ///< Reference to the edge that is annotated.
+		NodeID dest_node;        ///< Destination of the edge.
+		uint capacity;           ///< Capacity of the edge.
+		uint32_t travel_time;    ///< Average travel time of the edge, in ticks.
 
 		uint flow;               ///< Planned flow over this edge.
 
-		EdgeAnnotation(const LinkGraph::BaseEdge &base) : base(base), flow(0) {}
+		EdgeAnnotation(const LinkGraph::BaseEdge &base) : dest_node(base.dest_node), capacity(base.capacity), travel_time(base.capacity > 0 ? base.TravelTime() : 0), flow(0) {}
 
 		/**
 		 * Get the total flow on the edge.
@@ -70,7 +75,12 @@ public:
 
 		friend inline bool operator <(NodeID dest, const EdgeAnnotation &rhs)
 		{
-			return dest < rhs.base.dest_node;
+			return dest < rhs.dest_node;
+		}
+
+		friend inline bool operator <(const EdgeAnnotation &lhs, NodeID dest)
+		{
+			return lhs.dest_node < dest;
 		}
 	};
 
@@ -84,15 +94,11 @@ public:
 		PathList paths;          ///< Paths through this node, sorted so that those with flow == 0 are in the back.
 		FlowStatMap flows;       ///< Planned flows to other nodes.
 
-		std::vector<EdgeAnnotation>   edges;   ///< Annotations for all edges originating at this node.
-		std::vector<DemandAnnotation> demands; ///< Annotations for the demand to all other nodes.
+		std::span<EdgeAnnotation>   edges;   ///< Annotations for all edges originating at this node, sorted by destination. Part of LinkGraphJob::edges.
+		std::span<DemandAnnotation> demands; ///< Annotations for the demand to all other nodes. Part of LinkGraphJob::demands.
 
-		NodeAnnotation(const LinkGraph::BaseNode &node, size_t size) : base(node), undelivered_supply(node.supply), paths(), flows()
-		{
-			this->edges.reserve(node.edges.size());
-			for (auto &e : node.edges) this->edges.emplace_back(e);
-			this->demands.resize(size);
-		}
+		NodeAnnotation(const LinkGraph::BaseNode &node, std::span<EdgeAnnotation> edges, std::span<DemandAnnotation> demands) :
+				base(node), undelivered_supply(node.supply), paths(), flows(), edges(edges), demands(demands) {}
 
 		/**
 		 * Retrieve an edge starting at this node.
@@ -101,8 +107,8 @@ public:
 		 */
 		EdgeAnnotation &operator[](NodeID to)
 		{
-			auto it = std::find_if(this->edges.begin(), this->edges.end(), [=] (const EdgeAnnotation &e) { return e.base.dest_node == to; });
-			assert(it != this->edges.end());
+			auto it = std::lower_bound(this->edges.begin(), this->edges.end(), to);
+			assert(it != this->edges.end() && it->dest_node == to);
 			return *it;
 		}
 
@@ -113,8 +119,8 @@ public:
 		 */
 		const EdgeAnnotation &operator[](NodeID to) const
 		{
-			auto it = std::find_if(this->edges.begin(), this->edges.end(), [=] (const EdgeAnnotation &e) { return e.base.dest_node == to; });
-			assert(it != this->edges.end());
+			auto it = std::lower_bound(this->edges.begin(), this->edges.end(), to);
+			assert(it != this->edges.end() && it->dest_node == to);
 			return *it;
 		}
 
@@ -160,11 +166,13 @@ private:
 	friend class LinkGraphSchedule;
 
 protected:
-	const LinkGraph link_graph;        ///< Link graph to by analyzed. Is copied when job is started and mustn't be modified later.
+	const LinkGraph link_graph;        ///< Link graph to by analyzed. Is copied (copy-on-write) when job is started and mustn't be modified later.
 	const LinkGraphSettings settings;  ///< Copy of _settings_game.linkgraph at spawn time.
 	std::thread thread;                ///< Thread the job is running in or a default-constructed thread if it's running in the main thread.
 	TimerGameEconomy::Date join_date; ///< Date when the job is to be joined.
 	NodeAnnotationVector nodes;        ///< Extra node data necessary for link graph calculation.
+	std::vector<EdgeAnnotation> edges; ///< Annotations of the edges of all nodes, ordered by source node (compressed sparse rows); see NodeAnnotation::edges.
+	std::vector<DemandAnnotation> demands; ///< Annotations of the demands between all nodes, one row of Size() entries per source node.
 	std::atomic<bool> job_completed;   ///< Is the job still running. This is accessed by multiple threads and reads may be stale.
 	std::atomic<bool> job_aborted;     ///< Has the job been aborted. This is accessed by multiple threads and reads may be stale.
 
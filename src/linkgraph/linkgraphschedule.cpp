@@ -64,10 +64,11 @@ bool LinkGraphSchedule::IsJoinWithUnfinishedJobDue() const
 
 /**
  * Join the next finished job, if available.
+ * Nothing is joined while the join is postponed; see #JoinOverdue.
  */
 void LinkGraphSchedule::JoinNext()
 {
-	if (this->running.empty()) return;
+	if (this->running.empty() || this->join_postponed) return;
 	LinkGraphJob *next = this->running.front();
 	if (!next->IsScheduledToBeJoined()) return;
 	this->running.pop_front();
@@ -80,6 +81,28 @@ void LinkGraphSchedule::JoinNext()
 	}
 }
 
+/**
+ * Check if any job that is supposed to be finished has not yet completed.
+ * @return True if a job should be finished by now but is still running, false if not.
+ */
+bool LinkGraphSchedule::IsAnyOverdueJobUnfinished() const
+{
+	for (const LinkGraphJob *job : this->running) {
+		if (!job->IsScheduledToBeJoined()) break;
+		if (!job->IsJobCompleted()) return true;
+	}
+	return false;
+}
+
+/**
+ * End the postponement of the join, and join all jobs that are supposed to be finished by now.
+ */
+void LinkGraphSchedule::JoinOverdue()
+{
+	this->join_postponed = false;
+	while (!this->running.empty() && this->running.front()->IsScheduledToBeJoined()) this->JoinNext();
+}
+
 /**
  * Run all handlers for the given Job.
  * @param job Pointer to a link graph job.
@@ -125,6 +148,7 @@ void LinkGraphSchedule::SpawnAll()
 	}
 	instance.running.clear();
 	instance.schedule.clear();
+	instance.join_postponed = false;
 }
 
 /**
@@ -163,11 +187,30 @@ LinkGraphSchedule::~LinkGraphSchedule()
 }
 
 /**
- * Pause the game if in 2 TimerGameEconomy::date_fract ticks, we would do a join with the next
- * link graph job, but it is still running.
+ * Postpone the join of the link graph jobs that are due, or end that postponement and join them.
+ * @param flags type of operation
+ * @param postpone true to postpone the join, false to join all jobs that are due
+ * @return the cost of this operation or an error
+ */
+CommandCost CmdPostponeLinkGraphJoin(DoCommandFlag flags, bool postpone)
+{
+	if (flags & DC_EXEC) {
+		if (postpone) {
+			LinkGraphSchedule::instance.PostponeJoin();
+		} else {
+			LinkGraphSchedule::instance.JoinOverdue();
+		}
+	}
+	return CommandCost();
+}
+
+/**
+ * Handle a join with the next link graph job that is due in 2 TimerGameEconomy::date_fract ticks,
+ * but is still running. Network games postpone the join, so the clients keep playing. Other games
+ * pause, so the game state does not depend on how fast the job ran.
  * The check is done 2 TimerGameEconomy::date_fract ticks early instead of 1, as in multiplayer
  * calls to DoCommandP are executed after a delay of 1 TimerGameEconomy::date_fract tick.
- * If we previously paused, unpause if the job is now ready to be joined with.
+ * If we previously paused or postponed, unpause or join once the jobs are finished.
  */
 void StateGameLoop_LinkGraphPauseControl()
 {
@@ -176,13 +219,22 @@ void StateGameLoop_LinkGraphPauseControl()
 		if (!LinkGraphSchedule::instance.IsJoinWithUnfinishedJobDue()) {
 			Command<CMD_PAUSE>::Post(PM_PAUSED_LINK_GRAPH, false);
 		}
+	} else if (LinkGraphSchedule::instance.IsJoinPostponed()) {
+		/* The join is postponed, check the jobs every tick and join all that are due at once. */
+		if (!LinkGraphSchedule::instance.IsAnyOverdueJobUnfinished()) {
+			Command<CMD_POSTPONE_LINK_GRAPH_JOIN>::Post(false);
+		}
 	} else if (_pause_mode == PM_UNPAUSED &&
 			TimerGameEconomy::date_fract == LinkGraphSchedule::SPAWN_JOIN_TICK - 2 &&
 			TimerGameEconomy::date.base() % (_settings_game.linkgraph.recalc_interval / EconomyTime::SECONDS_PER_DAY) == (_settings_game.linkgraph.recalc_interval / EconomyTime::SECONDS_PER_DAY) / 2 &&
 			LinkGraphSchedule::instance.IsJoinWithUnfinishedJobDue()) {
 		/* Perform check two TimerGameEconomy::date_fract ticks before we would join, to make
 		 * sure it also works in multiplayer. */
-		Command<CMD_PAUSE>::Post(PM_PAUSED_LINK_GRAPH, true);
+		if (_networking) {
+			Command<CMD_POSTPONE_LINK_GRAPH_JOIN>::Post(true);
+		} else {
+			Command<CMD_PAUSE>::Post(PM_PAUSED_LINK_GRAPH, true);
+		}
 	}
 }
 
@@ -193,7 +245,7 @@ void StateGameLoop_LinkGraphPauseControl()
  */
 void AfterLoad_LinkGraphPauseControl()
 {
-	if (LinkGraphSchedule::instance.IsJoinWithUnfinishedJobDue()) {
+	if (!LinkGraphSchedule::instance.IsJoinPostponed() && LinkGraphSchedule::instance.IsJoinWithUnfinishedJobDue()) {
 		_pause_mode |= PM_PAUSED_LINK_GRAPH;
 	}
 }
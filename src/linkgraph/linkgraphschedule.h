@@ -45,6 +45,7 @@ protected:
 	ComponentHandler *handlers[6]; ///< Handlers to be run for each job.
 	GraphList schedule;            ///< Queue for new jobs.
 	JobList running;               ///< Currently running jobs.
+	bool join_postponed = false;   ///< Whether the join of the jobs that are due is postponed, as in a network game they were not finished yet.
 
 public:
 	/* This is a tick where not much else is happening, so a small lag might go unnoticed. */
@@ -57,9 +58,20 @@ public:
 	void SpawnNext();
 	bool IsJoinWithUnfinishedJobDue() const;
 	void JoinNext();
+	bool IsAnyOverdueJobUnfinished() const;
+	void JoinOverdue();
 	void SpawnAll();
 	void ShiftDates(TimerGameEconomy::Date interval);
 
+	/**
+	 * Check whether the join of the jobs that are due is postponed.
+	 * @return True if the join is postponed.
+	 */
+	bool IsJoinPostponed() const { return this->join_postponed; }
+
+	/** Postpone the join of the jobs that are due, until #JoinOverdue is called. */
+	void PostponeJoin() { this->join_postponed = true; }
+
 	/**
 	 * Queue a link graph for execution.
 	 * @param lg Link graph to be queued.
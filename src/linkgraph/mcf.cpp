@@ -95,8 +95,8 @@ class GraphEdgeIterator {
 private:
 	LinkGraphJob &job; ///< Job being executed
 
-	std::vector<LinkGraphJob::EdgeAnnotation>::const_iterator i;   ///< Iterator pointing to current edge.
-	std::vector<LinkGraphJob::EdgeAnnotation>::const_iterator end; ///< Iterator pointing beyond last edge.
+	std::span<LinkGraphJob::EdgeAnnotation>::iterator i;   ///< Iterator pointing to current edge.
+	std::span<LinkGraphJob::EdgeAnnotation>::iterator end; ///< Iterator pointing beyond last edge.
 
 public:
 
@@ -112,8 +112,8 @@ public:
 	 */
 	void SetNode(NodeID, NodeID node)
 	{
-		this->i = this->job[node].edges.cbegin();
-		this->end = this->job[node].edges.cend();
+		this->i = this->job[node].edges.begin();
+		this->end = this->job[node].edges.end();
 	}
 
 	/**
@@ -122,7 +122,7 @@ public:
 	 */
 	NodeID Next()
 	{
-		return this->i != this->end ? (this->i++)->base.dest_node : INVALID_NODE;
+		return this->i != this->end ? (this->i++)->dest_node : INVALID_NODE;
 	}
 };
 
@@ -260,6 +260,12 @@ void MultiCommodityFlow::Dijkstra(NodeID source_node, PathVector &paths)
 	Tedge_iterator iter(this->job);
 	uint16_t size = this->job.Size();
 	AnnoSet annos;
+	/* Prioritize the fastest route for passengers, mail and express cargo,
+	 * and the shortest route for other classes of cargo.
+	 * In-between stops are punished with a 1 tile or 1 day penalty. */
+	bool express = IsCargoInClass(this->job.Cargo(), CC_PASSENGERS) ||
+		IsCargoInClass(this->job.Cargo(), CC_MAIL) ||
+		IsCargoInClass(this->job.Cargo(), CC_EXPRESS);
 	paths.resize(size, nullptr);
 	for (NodeID node = 0; node < size; ++node) {
 		Tannotation *anno = new Tannotation(node, node == source_node);
@@ -276,21 +282,15 @@ void MultiCommodityFlow::Dijkstra(NodeID source_node, PathVector &paths)
 		for (NodeID to = iter.Next(); to != INVALID_NODE; to = iter.Next()) {
 			if (to == from) continue; // Not a real edge but a consumption sign.
 			const Edge &edge = this->job[from][to];
-			uint capacity = edge.base.capacity;
+			uint capacity = edge.capacity;
 			if (this->max_saturation != UINT_MAX) {
 				capacity *= this->max_saturation;
 				capacity /= 100;
 				if (capacity == 0) capacity = 1;
 			}
-			/* Prioritize the fastest route for passengers, mail and express cargo,
-			 * and the shortest route for other classes of cargo.
-			 * In-between stops are punished with a 1 tile or 1 day penalty. */
-			bool express = IsCargoInClass(this->job.Cargo(), CC_PASSENGERS) ||
-				IsCargoInClass(this->job.Cargo(), CC_MAIL) ||
-				IsCargoInClass(this->job.Cargo(), CC_EXPRESS);
 			uint distance = DistanceMaxPlusManhattan(this->job[from].base.xy, this->job[to].base.xy) + 1;
 			/* Compute a default travel time from the distance and an average speed of 1 tile/day. */
-			uint time = (edge.base.TravelTime() != 0) ? edge.base.TravelTime() + Ticks::DAY_TICKS : distance * Ticks::DAY_TICKS;
+			uint time = (edge.travel_time != 0) ? edge.travel_time + Ticks::DAY_TICKS : distance * Ticks::DAY_TICKS;
 			uint distance_anno = express ? time : distance;
 
 			Tannotation *dest = static_cast<Tannotation *>(paths[to]);
@@ -13,7 +13,15 @@
 #include "water_map.h"
 #include "error_func.h"
 #include "string_func.h"
+#include "landscape.h"
 #include "pathfinder/water_regions.h"
+#include "pathfinder/rail_regions.h"
+#include "pathfinder/road_regions.h"
+#include "pathfinder/yapf/yapf_cache.h"
+#include "pbs.h"
+#include "signal_func.h"
+#include "train.h"
+#include "vehicle_func.h"
 
 #include "safeguards.h"
 
@@ -60,6 +68,14 @@
 	Tile::extended_tiles = CallocT<Tile::TileExtended>(Map::size);
 
 	AllocateWaterRegions();
+	AllocateRailRegions();
+	AllocateRoadRegions();
+	YapfNotifyRoadLayoutChange(INVALID_TILE);
+	InvalidateReservationCache(INVALID_TILE);
+	InvalidateSignalSegments();
+	InvalidateTrainFreeRuns();
+	AllocateVehicleTileHash();
+	AllocateTileLoopIdleMap();
 }
 
 
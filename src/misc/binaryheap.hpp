@@ -266,6 +266,15 @@ public:
 		return it == this->data.end() ? 0 : std::distance(this->data.begin(), it);
 	}
 
+	/**
+	 * Get the number of items the heap can hold before it has to grow.
+	 * @return The capacity of the heap.
+	 */
+	inline size_t Capacity() const
+	{
+		return this->data.capacity();
+	}
+
 	/**
 	 * Make the priority queue empty.
 	 * All remaining items will remain untouched.
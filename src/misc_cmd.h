@@ -27,6 +27,7 @@ CommandCost CmdIncreaseLoan(DoCommandFlag flags, LoanCommand cmd, Money amount);
 CommandCost CmdDecreaseLoan(DoCommandFlag flags, LoanCommand cmd, Money amount);
 CommandCost CmdSetCompanyMaxLoan(DoCommandFlag flags, CompanyID company, Money amount);
 CommandCost CmdPause(DoCommandFlag flags, PauseMode mode, bool pause);
+CommandCost CmdPostponeLinkGraphJoin(DoCommandFlag flags, bool postpone);
 
 DEF_CMD_TRAIT(CMD_MONEY_CHEAT,          CmdMoneyCheat,        CMD_OFFLINE,             CMDT_CHEAT)
 DEF_CMD_TRAIT(CMD_CHANGE_BANK_BALANCE,  CmdChangeBankBalance, CMD_DEITY,               CMDT_MONEY_MANAGEMENT)
@@ -34,5 +35,6 @@ DEF_CMD_TRAIT(CMD_INCREASE_LOAN,        CmdIncreaseLoan,      0,
 DEF_CMD_TRAIT(CMD_DECREASE_LOAN,        CmdDecreaseLoan,      0,                       CMDT_MONEY_MANAGEMENT)
 DEF_CMD_TRAIT(CMD_SET_COMPANY_MAX_LOAN, CmdSetCompanyMaxLoan, CMD_DEITY,               CMDT_MONEY_MANAGEMENT)
 DEF_CMD_TRAIT(CMD_PAUSE,                CmdPause,             CMD_SERVER | CMD_NO_EST, CMDT_SERVER_SETTING)
+DEF_CMD_TRAIT(CMD_POSTPONE_LINK_GRAPH_JOIN, CmdPostponeLinkGraphJoin, CMD_SERVER | CMD_NO_EST, CMDT_SERVER_SETTING)
 
 #endif /* MISC_CMD_H */
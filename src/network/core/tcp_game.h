@@ -244,7 +244,9 @@ protected:
 	virtual NetworkRecvStatus Receive_SERVER_WELCOME(Packet &p);
 
 	/**
-	 * Request the map from the server.
+	 * Request the map from the server:
+	 * uint8_t   Number of savegame formats the client can load.
+	 * uint32_t  Tag of each of those savegame formats.
 	 * @param p The packet that was just received.
 	 */
 	virtual NetworkRecvStatus Receive_CLIENT_GETMAP(Packet &p);
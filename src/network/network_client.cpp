@@ -389,6 +389,10 @@ NetworkRecvStatus ClientNetworkGameSocketHandler::SendGetMap()
 	my_client->status = STATUS_MAP_WAIT;
 
 	auto p = std::make_unique<Packet>(my_client, PACKET_CLIENT_GETMAP);
+	/* Tell which formats we can load, so the server does not send a map compressed in a format we were built without. */
+	std::vector<uint32_t> formats = GetLoadableSavegameFormats();
+	p->Send_uint8(static_cast<uint8_t>(formats.size()));
+	for (uint32_t tag : formats) p->Send_uint32(tag);
 	my_client->SendPacket(std::move(p));
 	return NETWORK_RECV_STATUS_OKAY;
 }
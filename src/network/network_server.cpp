@@ -578,7 +578,7 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendMap()
 		this->last_frame_server = _frame_counter;
 
 		/* Make a dump of the current game */
-		if (SaveWithFilter(this->savegame, true) != SL_OK) UserError("network savedump failed");
+		if (SaveWithFilter(this->savegame, true, GetSavegameFormatLoadableWith(this->savegame_formats), CanWriteSavegameBlocksLoadableWith(this->savegame_formats)) != SL_OK) UserError("network savedump failed");
 	}
 
 	if (this->status == STATUS_MAP) {
@@ -985,7 +985,7 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_AUTH_RESPONSE(P
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
-NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_GETMAP(Packet &)
+NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_GETMAP(Packet &p)
 {
 	/* The client was never joined.. so this is impossible, right?
 	 *  Ignore the packet, give the client a warning, and close the connection */
@@ -995,6 +995,10 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_GETMAP(Packet &
 
 	Debug(net, 9, "client[{}] Receive_CLIENT_GETMAP()", this->client_id);
 
+	this->savegame_formats.clear();
+	uint8_t formats = p.Recv_uint8();
+	for (uint8_t i = 0; i < formats; i++) this->savegame_formats.push_back(p.Recv_uint32());
+
 	/* Check if someone else is receiving the map */
 	for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
 		if (new_cs->status == STATUS_MAP) {
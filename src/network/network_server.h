@@ -25,6 +25,7 @@ class ServerNetworkGameSocketHandler : public NetworkClientSocketPool::PoolItem<
 protected:
 	std::unique_ptr<class NetworkAuthenticationServerHandler> authentication_handler; ///< The handler for the authentication.
 	std::string peer_public_key; ///< The public key of our client.
+	std::vector<uint32_t> savegame_formats; ///< Tags of the savegame formats our client can load the map with.
 
 	NetworkRecvStatus Receive_CLIENT_JOIN(Packet &p) override;
 	NetworkRecvStatus Receive_CLIENT_IDENTIFY(Packet &p) override;
@@ -29,6 +29,9 @@ static const int YAPF_INFINITE_PENALTY = 1000 * YAPF_TILE_LENGTH;
 /** Maximum segments of road vehicle path cache */
 static const int YAPF_ROADVEH_PATH_CACHE_SEGMENTS = 8;
 
+/** Maximum segments of road vehicle path cache, when the destination is more than one road region away */
+static const int YAPF_ROADVEH_PATH_CACHE_SEGMENTS_DISTANT = 32;
+
 /** Distance from destination road stops to not cache any further */
 static const int YAPF_ROADVEH_PATH_CACHE_DESTINATION_LIMIT = 8;
 
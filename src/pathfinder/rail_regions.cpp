@@ -0,0 +1,208 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ /** @file rail_regions.cpp Handles dividing the tracks in the map into square regions to assist pathfinding. */
+
+#include "stdafx.h"
+#include "rail_regions.h"
+#include "tilearea_type.h"
+#include "track_func.h"
+#include "transport_type.h"
+#include "landscape.h"
+#include "tunnelbridge_map.h"
+#include "debug.h"
+
+#include <queue>
+#include <unordered_map>
+
+#include "safeguards.h"
+
+/** Maximum number of rail regions to look at when searching for a corridor, before giving up. */
+static const uint MAX_CORRIDOR_SEARCH_REGIONS = 4096;
+
+static inline int GetRailRegionX(TileIndex tile) { return TileX(tile) / RAIL_REGION_EDGE_LENGTH; }
+static inline int GetRailRegionY(TileIndex tile) { return TileY(tile) / RAIL_REGION_EDGE_LENGTH; }
+
+static inline int GetRailRegionMapSizeX() { return Map::SizeX() / RAIL_REGION_EDGE_LENGTH; }
+static inline int GetRailRegionMapSizeY() { return Map::SizeY() / RAIL_REGION_EDGE_LENGTH; }
+
+static inline TRailRegionIndex GetRailRegionIndex(int region_x, int region_y) { return GetRailRegionMapSizeX() * region_y + region_x; }
+static inline int GetRailRegionXByIndex(TRailRegionIndex index) { return index % GetRailRegionMapSizeX(); }
+static inline int GetRailRegionYByIndex(TRailRegionIndex index) { return index / GetRailRegionMapSizeX(); }
+
+/**
+ * For every rail region the sorted list of other regions a train can enter directly from a track in the region.
+ * This only depends on the tracks within the region itself, and the far ends of tunnels and bridges starting
+ * in it. Whether the track continues in the other region is not checked, so the connections are a superset
+ * of those a train can actually use. Railtypes and owners are ignored for the same reason.
+ */
+static std::vector<std::vector<TRailRegionIndex>> _rail_region_neighbours;
+static std::vector<bool> _is_rail_region_valid;
+
+/**
+ * Returns the index of the rail region the tile is part of.
+ * @param tile The tile to return the region index for.
+ * @return The index of the rail region.
+ */
+TRailRegionIndex GetRailRegionIndex(TileIndex tile)
+{
+	return GetRailRegionIndex(GetRailRegionX(tile), GetRailRegionY(tile));
+}
+
+/**
+ * Get the regions a train can enter from the tracks in a region, recalculating them when the region has been invalidated.
+ * @param index The rail region to get the neighbours of.
+ * @return The sorted indices of the regions that can be entered.
+ */
+static const std::vector<TRailRegionIndex> &GetRailRegionNeighbours(TRailRegionIndex index)
+{
+	std::vector<TRailRegionIndex> &neighbours = _rail_region_neighbours[index];
+	if (_is_rail_region_valid[index]) return neighbours;
+
+	neighbours.clear();
+	const TileArea area(TileXY(GetRailRegionXByIndex(index) * RAIL_REGION_EDGE_LENGTH, GetRailRegionYByIndex(index) * RAIL_REGION_EDGE_LENGTH), RAIL_REGION_EDGE_LENGTH, RAIL_REGION_EDGE_LENGTH);
+	for (const TileIndex tile : area) {
+		const TrackdirBits trackdirs = TrackStatusToTrackdirBits(GetTileTrackStatus(tile, TRANSPORT_RAIL, 0));
+		for (Trackdir td : SetTrackdirBitIterator(trackdirs)) {
+			const DiagDirection exitdir = TrackdirToExitdir(td);
+			TileIndex next;
+			if (IsTileType(tile, MP_TUNNELBRIDGE) && GetTunnelBridgeDirection(tile) == exitdir) {
+				next = GetOtherTunnelBridgeEnd(tile);
+			} else {
+				next = TileAddByDiagDir(tile, exitdir);
+				if (!IsValidTile(next)) continue;
+			}
+
+			const TRailRegionIndex next_index = GetRailRegionIndex(next);
+			if (next_index != index) neighbours.push_back(next_index);
+		}
+	}
+	std::sort(neighbours.begin(), neighbours.end());
+	neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+
+	_is_rail_region_valid[index] = true;
+	return neighbours;
+}
+
+/**
+ * Marks the rail region that tile is part of as invalid.
+ * The connections of a region only depend on tiles within the region and the far ends of its tunnels and
+ * bridges, so the adjacent regions stay valid. For a tunnel or bridge head the region of the other head is
+ * invalidated as well, as the connections of both regions change when it is built.
+ * @param tile Tile within the rail region that we wish to invalidate.
+ */
+void InvalidateRailRegion(TileIndex tile)
+{
+	if (!IsValidTile(tile)) return;
+
+	const TRailRegionIndex index = GetRailRegionIndex(tile);
+	if (_is_rail_region_valid[index]) Debug(map, 3, "Invalidated rail region ({},{})", GetRailRegionX(tile), GetRailRegionY(tile));
+	_is_rail_region_valid[index] = false;
+
+	if (IsTileType(tile, MP_TUNNELBRIDGE)) _is_rail_region_valid[GetRailRegionIndex(GetOtherTunnelBridgeEnd(tile))] = false;
+}
+
+/** Marks all rail regions as invalid. */
+void InvalidateAllRailRegions()
+{
+	std::fill(_is_rail_region_valid.begin(), _is_rail_region_valid.end(), false);
+}
+
+/**
+ * Find a route through the rail regions from the region of one tile to that of another.
+ * @param origin Tile to start at.
+ * @param destination Tile to route to.
+ * @return The sorted indices of the regions along the route together with the regions directly around them,
+ *         or an empty vector when no route was found.
+ */
+std::vector<TRailRegionIndex> FindRailRegionCorridor(TileIndex origin, TileIndex destination)
+{
+	const TRailRegionIndex start = GetRailRegionIndex(origin);
+	const TRailRegionIndex goal = GetRailRegionIndex(destination);
+
+	auto estimate = [goal](TRailRegionIndex index) -> uint {
+		return abs(GetRailRegionXByIndex(index) - GetRailRegionXByIndex(goal)) + abs(GetRailRegionYByIndex(index) - GetRailRegionYByIndex(goal));
+	};
+
+	/* Plain A* over the regions; the cost of a step is the distance between the regions, so tunnels and bridges are not free. */
+	struct Visited {
+		uint cost; ///< Cost of the cheapest route to the region found so far.
+		TRailRegionIndex parent; ///< Previous region on that route.
+		bool closed; ///< Whether the region has been expanded.
+	};
+	std::unordered_map<TRailRegionIndex, Visited> visited;
+	using OpenItem = std::pair<uint, TRailRegionIndex>; // Estimated total cost and region; ties are resolved by region index.
+	std::priority_queue<OpenItem, std::vector<OpenItem>, std::greater<OpenItem>> open;
+
+	visited[start] = { 0, start, false };
+	open.emplace(estimate(start), start);
+
+	uint expanded = 0;
+	bool found = false;
+	while (!open.empty()) {
+		const TRailRegionIndex index = open.top().second;
+		open.pop();
+
+		Visited &current = visited[index];
+		if (current.closed) continue;
+		current.closed = true;
+
+		if (index == goal) {
+			found = true;
+			break;
+		}
+		if (++expanded > MAX_CORRIDOR_SEARCH_REGIONS) break;
+
+		const uint cost = current.cost;
+		for (const TRailRegionIndex next : GetRailRegionNeighbours(index)) {
+			const uint next_cost = cost + abs(GetRailRegionXByIndex(next) - GetRailRegionXByIndex(index)) + abs(GetRailRegionYByIndex(next) - GetRailRegionYByIndex(index));
+			auto [it, inserted] = visited.try_emplace(next, Visited{ next_cost, index, false });
+			if (!inserted) {
+				if (it->second.closed || it->second.cost <= next_cost) continue;
+				it->second = { next_cost, index, false };
+			}
+			open.emplace(next_cost + estimate(next), next);
+		}
+	}
+
+	std::vector<TRailRegionIndex> corridor;
+	if (!found) return corridor;
+
+	/* Widen the route by the regions around it, so the pathfinder has some room to choose between parallel tracks. */
+	const int size_x = GetRailRegionMapSizeX();
+	const int size_y = GetRailRegionMapSizeY();
+	for (TRailRegionIndex index = goal;; index = visited[index].parent) {
+		const int x = GetRailRegionXByIndex(index);
+		const int y = GetRailRegionYByIndex(index);
+		for (int dy = -1; dy <= 1; dy++) {
+			for (int dx = -1; dx <= 1; dx++) {
+				if (x + dx < 0 || y + dy < 0 || x + dx >= size_x || y + dy >= size_y) continue;
+				corridor.push_back(GetRailRegionIndex(x + dx, y + dy));
+			}
+		}
+		if (index == start) break;
+	}
+	std::sort(corridor.begin(), corridor.end());
+	corridor.erase(std::unique(corridor.begin(), corridor.end()), corridor.end());
+
+	Debug(yapf, 4, "Rail region corridor from {} to {}: {} regions after expanding {}", origin.base(), destination.base(), corridor.size(), expanded);
+	return corridor;
+}
+
+/**
+ * Allocates the appropriate amount of rail regions for the current map size
+ */
+void AllocateRailRegions()
+{
+	const int number_of_regions = GetRailRegionMapSizeX() * GetRailRegionMapSizeY();
+
+	_rail_region_neighbours.clear();
+	_rail_region_neighbours.resize(number_of_regions);
+
+	_is_rail_region_valid.clear();
+	_is_rail_region_valid.resize(number_of_regions, false);
+}
@@ -0,0 +1,29 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ /** @file rail_regions.h Handles dividing the tracks in the map into regions to assist pathfinding. */
+
+#ifndef RAIL_REGIONS_H
+#define RAIL_REGIONS_H
+
+#include "tile_type.h"
+#include "map_func.h"
+
+using TRailRegionIndex = uint;
+
+constexpr int RAIL_REGION_EDGE_LENGTH = 16;
+
+TRailRegionIndex GetRailRegionIndex(TileIndex tile);
+
+void InvalidateRailRegion(TileIndex tile);
+void InvalidateAllRailRegions();
+
+std::vector<TRailRegionIndex> FindRailRegionCorridor(TileIndex origin, TileIndex destination);
+
+void AllocateRailRegions();
+
+#endif /* RAIL_REGIONS_H */
@@ -0,0 +1,350 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ /** @file road_regions.cpp Handles dividing the roads in the map into square regions to assist pathfinding. */
+
+#include "stdafx.h"
+#include "road_regions.h"
+#include "tilearea_type.h"
+#include "road_map.h"
+#include "station_map.h"
+#include "tunnelbridge_map.h"
+#include "debug.h"
+
+#include <queue>
+#include <unordered_map>
+
+#include "safeguards.h"
+
+/** Maximum number of road region patches to look at when searching for a corridor, before giving up. */
+static const uint MAX_CORRIDOR_SEARCH_PATCHES = 4096;
+
+static inline int GetRoadRegionX(TileIndex tile) { return TileX(tile) / ROAD_REGION_EDGE_LENGTH; }
+static inline int GetRoadRegionY(TileIndex tile) { return TileY(tile) / ROAD_REGION_EDGE_LENGTH; }
+
+static inline int GetRoadRegionMapSizeX() { return Map::SizeX() / ROAD_REGION_EDGE_LENGTH; }
+static inline int GetRoadRegionMapSizeY() { return Map::SizeY() / ROAD_REGION_EDGE_LENGTH; }
+
+static inline TRoadRegionIndex GetRoadRegionIndex(int region_x, int region_y) { return GetRoadRegionMapSizeX() * region_y + region_x; }
+static inline int GetRoadRegionXByIndex(TRoadRegionIndex index) { return index % GetRoadRegionMapSizeX(); }
+static inline int GetRoadRegionYByIndex(TRoadRegionIndex index) { return index / GetRoadRegionMapSizeX(); }
+
+static inline int GetLocalIndex(TileIndex tile) { return (TileX(tile) % ROAD_REGION_EDGE_LENGTH) + (TileY(tile) % ROAD_REGION_EDGE_LENGTH) * ROAD_REGION_EDGE_LENGTH; }
+
+using TRoadRegionPatchLabelArray = std::array<TRoadRegionPatchLabel, ROAD_REGION_NUMBER_OF_TILES>;
+
+/**
+ * The data stored for each road region, for one of road and tram.
+ */
+struct RoadRegionData {
+	std::unique_ptr<TRoadRegionPatchLabelArray> tile_patch_labels; ///< Patch label of every tile, nullptr when the region has no road.
+	TRoadRegionPatchLabel number_of_patches = 0; ///< 0 = no road, 1 = one single patch of road, etc...
+	bool valid = false; ///< Whether the labels match the current map.
+};
+
+static std::array<std::vector<RoadRegionData>, 2> _road_region_data; ///< The data of each road region, indexed by #RoadTramType.
+
+/**
+ * Get the sides of a tile through which road of the given type leaves it.
+ * This only looks at the layout of the road, so one way roads, road works and closed level crossings are ignored.
+ * @param tile The tile to check.
+ * @param rtt Whether to look at road or tram.
+ * @return Bitmask of DiagDirection.
+ */
+static uint8_t GetRoadExits(TileIndex tile, RoadTramType rtt)
+{
+	switch (GetTileType(tile)) {
+		case MP_ROAD: {
+			if (!HasTileRoadType(tile, rtt)) return 0;
+			if (IsRoadDepot(tile)) return 1 << GetRoadDepotDirection(tile);
+			RoadBits bits = IsLevelCrossing(tile) ? GetCrossingRoadBits(tile) : GetRoadBits(tile, rtt);
+			uint8_t exits = 0;
+			for (DiagDirection dir = DIAGDIR_BEGIN; dir < DIAGDIR_END; dir++) {
+				if ((bits & DiagDirToRoadBits(dir)) != ROAD_NONE) SetBit(exits, dir);
+			}
+			return exits;
+		}
+
+		case MP_STATION:
+			if (!IsAnyRoadStop(tile) || !HasTileRoadType(tile, rtt)) return 0;
+			if (IsDriveThroughStopTile(tile)) return (1 << GetRoadStopDir(tile)) | (1 << ReverseDiagDir(GetRoadStopDir(tile)));
+			return 1 << GetRoadStopDir(tile);
+
+		case MP_TUNNELBRIDGE:
+			if (GetTunnelBridgeTransportType(tile) != TRANSPORT_ROAD || !HasTileRoadType(tile, rtt)) return 0;
+			return (1 << GetTunnelBridgeDirection(tile)) | (1 << ReverseDiagDir(GetTunnelBridgeDirection(tile)));
+
+		default:
+			return 0;
+	}
+}
+
+/**
+ * Get the tile reached by leaving a tile through one of its sides.
+ * @param tile The tile to leave.
+ * @param dir The side to leave through.
+ * @return The reached tile, which is the other end when entering a tunnel or bridge.
+ */
+static TileIndex GetRoadExitTile(TileIndex tile, DiagDirection dir)
+{
+	if (IsTileType(tile, MP_TUNNELBRIDGE) && GetTunnelBridgeDirection(tile) == dir) return GetOtherTunnelBridgeEnd(tile);
+	return TileAddByDiagDir(tile, dir);
+}
+
+/**
+ * Call a function for every tile that is connected by road to a tile, in either direction.
+ * @param tile The tile to find the connections of.
+ * @param rtt Whether to look at road or tram.
+ * @param func Function to call with each connected tile.
+ */
+template <typename Func>
+static void VisitRoadConnections(TileIndex tile, RoadTramType rtt, Func func)
+{
+	const uint8_t exits = GetRoadExits(tile, rtt);
+	if (exits == 0) return;
+
+	for (DiagDirection dir = DIAGDIR_BEGIN; dir < DIAGDIR_END; dir++) {
+		if (HasBit(exits, dir)) {
+			const TileIndex next = GetRoadExitTile(tile, dir);
+			if (IsValidTile(next) && GetRoadExits(next, rtt) != 0) func(next);
+		} else {
+			/* The road might still come in from the neighbour, e.g. into the side of a road stop. */
+			const TileIndex next = TileAddByDiagDir(tile, dir);
+			if (IsValidTile(next) && HasBit(GetRoadExits(next, rtt), ReverseDiagDir(dir)) && GetRoadExitTile(next, ReverseDiagDir(dir)) == tile) func(next);
+		}
+	}
+}
+
+/**
+ * Label the connected patches of road in a region.
+ * @param index The road region to update.
+ * @param rtt Whether to look at road or tram.
+ */
+static void UpdateRoadRegion(TRoadRegionIndex index, RoadTramType rtt)
+{
+	RoadRegionData &data = _road_region_data[rtt][index];
+	data.number_of_patches = 0;
+	data.tile_patch_labels.reset();
+	data.valid = true;
+
+	const TileArea area(TileXY(GetRoadRegionXByIndex(index) * ROAD_REGION_EDGE_LENGTH, GetRoadRegionYByIndex(index) * ROAD_REGION_EDGE_LENGTH), ROAD_REGION_EDGE_LENGTH, ROAD_REGION_EDGE_LENGTH);
+
+	std::vector<TileIndex> tiles_to_check;
+	for (const TileIndex start_tile : area) {
+		if (data.tile_patch_labels != nullptr && (*data.tile_patch_labels)[GetLocalIndex(start_tile)] != INVALID_ROAD_REGION_PATCH) continue;
+		if (GetRoadExits(start_tile, rtt) == 0) continue;
+
+		if (data.tile_patch_labels == nullptr) {
+			data.tile_patch_labels = std::make_unique<TRoadRegionPatchLabelArray>();
+			data.tile_patch_labels->fill(INVALID_ROAD_REGION_PATCH);
+		}
+
+		/* A region has at most half of its tiles as separate patches, so the labels do not overflow. */
+		const TRoadRegionPatchLabel label = ++data.number_of_patches;
+		(*data.tile_patch_labels)[GetLocalIndex(start_tile)] = label;
+		tiles_to_check.push_back(start_tile);
+		while (!tiles_to_check.empty()) {
+			const TileIndex tile = tiles_to_check.back();
+			tiles_to_check.pop_back();
+			VisitRoadConnections(tile, rtt, [&](TileIndex next) {
+				if (!area.Contains(next)) return;
+				TRoadRegionPatchLabel &next_label = (*data.tile_patch_labels)[GetLocalIndex(next)];
+				if (next_label != INVALID_ROAD_REGION_PATCH) return;
+				next_label = label;
+				tiles_to_check.push_back(next);
+			});
+		}
+	}
+}
+
+/**
+ * Get the data of a road region, updating it when the region has been invalidated.
+ * @param index The road region.
+ * @param rtt Whether to look at road or tram.
+ * @return The up to date data of the region.
+ */
+static const RoadRegionData &GetUpdatedRoadRegion(TRoadRegionIndex index, RoadTramType rtt)
+{
+	if (!_road_region_data[rtt][index].valid) UpdateRoadRegion(index, rtt);
+	return _road_region_data[rtt][index];
+}
+
+/**
+ * Returns the index of the road region the tile is part of.
+ * @param tile The tile to return the region index for.
+ * @return The index of the road region.
+ */
+TRoadRegionIndex GetRoadRegionIndex(TileIndex tile)
+{
+	return GetRoadRegionIndex(GetRoadRegionX(tile), GetRoadRegionY(tile));
+}
+
+/**
+ * Returns the label of the road patch within its region the tile is part of.
+ * @param tile The tile to get the label of.
+ * @param rtt Whether to look at road or tram.
+ * @return The label, or #INVALID_ROAD_REGION_PATCH when there is no road of the given type on the tile.
+ */
+TRoadRegionPatchLabel GetRoadRegionPatchLabel(TileIndex tile, RoadTramType rtt)
+{
+	const RoadRegionData &data = GetUpdatedRoadRegion(GetRoadRegionIndex(tile), rtt);
+	if (data.tile_patch_labels == nullptr) return INVALID_ROAD_REGION_PATCH;
+	return (*data.tile_patch_labels)[GetLocalIndex(tile)];
+}
+
+/**
+ * Get the distance between the road regions of two tiles.
+ * @param tile1 The first tile.
+ * @param tile2 The second tile.
+ * @return The Manhattan distance in road regions.
+ */
+uint GetRoadRegionDistance(TileIndex tile1, TileIndex tile2)
+{
+	return abs(GetRoadRegionX(tile1) - GetRoadRegionX(tile2)) + abs(GetRoadRegionY(tile1) - GetRoadRegionY(tile2));
+}
+
+/**
+ * Marks the road region that tile is part of as invalid.
+ * @param tile Tile within the road region that we wish to invalidate.
+ */
+void InvalidateRoadRegion(TileIndex tile)
+{
+	if (!IsValidTile(tile)) return;
+
+	const TRoadRegionIndex index = GetRoadRegionIndex(tile);
+	for (RoadTramType rtt : _roadtramtypes) {
+		if (_road_region_data[rtt][index].valid) Debug(map, 3, "Invalidated {} region ({},{})", rtt == RTT_TRAM ? "tram" : "road", GetRoadRegionX(tile), GetRoadRegionY(tile));
+		_road_region_data[rtt][index].valid = false;
+	}
+}
+
+/** Marks all road regions as invalid. */
+void InvalidateAllRoadRegions()
+{
+	for (std::vector<RoadRegionData> &data : _road_region_data) {
+		for (RoadRegionData &region : data) region.valid = false;
+	}
+}
+
+/** Identifier of a patch of road in a region, for use in the corridor search. */
+using TRoadRegionPatchKey = uint64_t;
+
+static inline TRoadRegionPatchKey GetRoadRegionPatchKey(TRoadRegionIndex index, TRoadRegionPatchLabel label) { return static_cast<TRoadRegionPatchKey>(index) << 8 | label; }
+static inline TRoadRegionIndex GetRoadRegionIndexOfPatch(TRoadRegionPatchKey key) { return static_cast<TRoadRegionIndex>(key >> 8); }
+
+/**
+ * Find a route through the patches of road from the patch of one tile to that of another.
+ * @param origin Tile to start at.
+ * @param destination Tile to route to.
+ * @param rtt Whether to look at road or tram.
+ * @return The sorted indices of the regions of the patches along the route, or an empty vector when no route was found.
+ */
+std::vector<TRoadRegionIndex> FindRoadRegionCorridor(TileIndex origin, TileIndex destination, RoadTramType rtt)
+{
+	std::vector<TRoadRegionIndex> corridor;
+
+	const TRoadRegionPatchLabel start_label = GetRoadRegionPatchLabel(origin, rtt);
+	const TRoadRegionPatchLabel goal_label = GetRoadRegionPatchLabel(destination, rtt);
+	if (start_label == INVALID_ROAD_REGION_PATCH || goal_label == INVALID_ROAD_REGION_PATCH) return corridor;
+
+	const TRoadRegionPatchKey start = GetRoadRegionPatchKey(GetRoadRegionIndex(origin), start_label);
+	const TRoadRegionPatchKey goal = GetRoadRegionPatchKey(GetRoadRegionIndex(destination), goal_label);
+	const int goal_x = GetRoadRegionX(destination);
+	const int goal_y = GetRoadRegionY(destination);
+
+	auto estimate = [goal_x, goal_y](TRoadRegionIndex index) -> uint {
+		return abs(GetRoadRegionXByIndex(index) - goal_x) + abs(GetRoadRegionYByIndex(index) - goal_y);
+	};
+
+	/* Plain A* over the patches; the cost of a step is the distance between the regions, so tunnels and bridges are not free. */
+	struct Visited {
+		uint cost; ///< Cost of the cheapest route to the patch found so far.
+		TRoadRegionPatchKey parent; ///< Previous patch on that route.
+		bool closed; ///< Whether the patch has been expanded.
+	};
+	std::unordered_map<TRoadRegionPatchKey, Visited> visited;
+	using OpenItem = std::pair<uint, TRoadRegionPatchKey>; // Estimated total cost and patch; ties are resolved by the patch key.
+	std::priority_queue<OpenItem, std::vector<OpenItem>, std::greater<OpenItem>> open;
+
+	visited[start] = { 0, start, false };
+	open.emplace(estimate(GetRoadRegionIndexOfPatch(start)), start);
+
+	std::vector<TRoadRegionPatchKey> neighbours;
+	uint expanded = 0;
+	bool found = false;
+	while (!open.empty()) {
+		const TRoadRegionPatchKey key = open.top().second;
+		open.pop();
+
+		Visited &current = visited[key];
+		if (current.closed) continue;
+		current.closed = true;
+
+		if (key == goal) {
+			found = true;
+			break;
+		}
+		if (++expanded > MAX_CORRIDOR_SEARCH_PATCHES) break;
+
+		/* Collect the patches in other regions connected to this patch, via the region edges or via tunnels and bridges. */
+		const TRoadRegionIndex index = GetRoadRegionIndexOfPatch(key);
+		const TileArea area(TileXY(GetRoadRegionXByIndex(index) * ROAD_REGION_EDGE_LENGTH, GetRoadRegionYByIndex(index) * ROAD_REGION_EDGE_LENGTH), ROAD_REGION_EDGE_LENGTH, ROAD_REGION_EDGE_LENGTH);
+		const RoadRegionData &data = GetUpdatedRoadRegion(index, rtt);
+		neighbours.clear();
+		for (const TileIndex tile : area) {
+			const int local_x = TileX(tile) % ROAD_REGION_EDGE_LENGTH;
+			const int local_y = TileY(tile) % ROAD_REGION_EDGE_LENGTH;
+			const bool is_edge = local_x == 0 || local_y == 0 || local_x == ROAD_REGION_EDGE_LENGTH - 1 || local_y == ROAD_REGION_EDGE_LENGTH - 1;
+			if (!is_edge && !IsTileType(tile, MP_TUNNELBRIDGE)) continue;
+			if (GetRoadRegionPatchKey(index, (*data.tile_patch_labels)[GetLocalIndex(tile)]) != key) continue;
+
+			VisitRoadConnections(tile, rtt, [&](TileIndex next) {
+				if (area.Contains(next)) return;
+				neighbours.push_back(GetRoadRegionPatchKey(GetRoadRegionIndex(next), GetRoadRegionPatchLabel(next, rtt)));
+			});
+		}
+		std::sort(neighbours.begin(), neighbours.end());
+		neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+
+		const uint cost = current.cost;
+		for (const TRoadRegionPatchKey next : neighbours) {
+			const TRoadRegionIndex next_index = GetRoadRegionIndexOfPatch(next);
+			const uint next_cost = cost + abs(GetRoadRegionXByIndex(next_index) - GetRoadRegionXByIndex(index)) + abs(GetRoadRegionYByIndex(next_index) - GetRoadRegionYByIndex(index));
+			auto [it, inserted] = visited.try_emplace(next, Visited{ next_cost, key, false });
+			if (!inserted) {
+				if (it->second.closed || it->second.cost <= next_cost) continue;
+				it->second = { next_cost, key, false };
+			}
+			open.emplace(next_cost + estimate(next_index), next);
+		}
+	}
+
+	if (!found) return corridor;
+
+	for (TRoadRegionPatchKey key = goal;; key = visited[key].parent) {
+		corridor.push_back(GetRoadRegionIndexOfPatch(key));
+		if (key == start) break;
+	}
+	std::sort(corridor.begin(), corridor.end());
+	corridor.erase(std::unique(corridor.begin(), corridor.end()), corridor.end());
+
+	Debug(yapf, 4, "Road region corridor from {} to {}: {} regions after expanding {} patches", origin.base(), destination.base(), corridor.size(), expanded);
+	return corridor;
+}
+
+/**
+ * Allocates the appropriate amount of road regions for the current map size
+ */
+void AllocateRoadRegions()
+{
+	const int number_of_regions = GetRoadRegionMapSizeX() * GetRoadRegionMapSizeY();
+
+	for (std::vector<RoadRegionData> &data : _road_region_data) {
+		data.clear();
+		data.resize(number_of_regions);
+	}
+}
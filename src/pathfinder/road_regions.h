@@ -0,0 +1,35 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ /** @file road_regions.h Handles dividing the roads in the map into regions to assist pathfinding. */
+
+#ifndef ROAD_REGIONS_H
+#define ROAD_REGIONS_H
+
+#include "tile_type.h"
+#include "map_func.h"
+#include "road.h"
+
+using TRoadRegionPatchLabel = uint8_t;
+using TRoadRegionIndex = uint;
+
+constexpr int ROAD_REGION_EDGE_LENGTH = 16;
+constexpr int ROAD_REGION_NUMBER_OF_TILES = ROAD_REGION_EDGE_LENGTH * ROAD_REGION_EDGE_LENGTH;
+constexpr TRoadRegionPatchLabel INVALID_ROAD_REGION_PATCH = 0;
+
+TRoadRegionIndex GetRoadRegionIndex(TileIndex tile);
+TRoadRegionPatchLabel GetRoadRegionPatchLabel(TileIndex tile, RoadTramType rtt);
+uint GetRoadRegionDistance(TileIndex tile1, TileIndex tile2);
+
+void InvalidateRoadRegion(TileIndex tile);
+void InvalidateAllRoadRegions();
+
+std::vector<TRoadRegionIndex> FindRoadRegionCorridor(TileIndex origin, TileIndex destination, RoadTramType rtt);
+
+void AllocateRoadRegions();
+
+#endif /* ROAD_REGIONS_H */
@@ -19,6 +19,10 @@
 #include "follow_track.hpp"
 #include "ship.h"
 #include "debug.h"
+#include "settings_type.h"
+#include "thread_pool.h"
+
+#include <chrono>
 
 using TWaterRegionTraversabilityBits = uint16_t;
 constexpr TWaterRegionPatchLabel FIRST_REGION_LABEL = 1;
@@ -142,7 +146,7 @@ public:
 		/* Perform connected component labeling. This uses a flooding algorithm that expands until no
 		 * additional tiles can be added. Only tiles inside the water region are considered. */
 		for (const TileIndex start_tile : tile_area) {
-			static std::vector<TileIndex> tiles_to_check;
+			static thread_local std::vector<TileIndex> tiles_to_check;
 			tiles_to_check.clear();
 			tiles_to_check.push_back(start_tile);
 
@@ -222,6 +226,24 @@ public:
 std::vector<WaterRegionData> _water_region_data;
 std::vector<bool> _is_water_region_valid;
 
+/** Maximum number of water regions to rebuild ahead of time per tick. */
+static const size_t MAX_WATER_REGION_REBUILDS_PER_TICK = 64;
+/** Minimum number of water regions to rebuild on one thread when rebuilding in parallel. */
+static const size_t MIN_PARALLEL_WATER_REGION_REBUILDS = 8;
+
+/** Water regions that might need to be rebuilt, oldest invalidation first. Every invalid water region is in here. */
+static std::deque<TWaterRegionIndex> _dirty_water_regions;
+
+/** Statistics of rebuilding water regions, for debugging. */
+struct WaterRegionRebuildStats {
+	uint64_t eager_rebuilds = 0;              ///< Number of water regions rebuilt ahead of time.
+	uint64_t lazy_rebuilds = 0;               ///< Number of water regions rebuilt when they were needed.
+	std::chrono::microseconds eager_time{};   ///< Total time spent on rebuilding water regions ahead of time.
+	std::chrono::microseconds lazy_time{};    ///< Total time spent on rebuilding water regions when they were needed.
+	std::chrono::microseconds max_lazy_time{}; ///< Longest time it took to rebuild a water region when it was needed.
+};
+static WaterRegionRebuildStats _water_region_rebuild_stats;
+
 TileIndex GetTileIndexFromLocalCoordinate(int region_x, int region_y, int local_x, int local_y)
 {
 	assert(local_x >= 0 && local_x < WATER_REGION_EDGE_LENGTH);
@@ -246,8 +268,14 @@ WaterRegion GetUpdatedWaterRegion(uint16_t region_x, uint16_t region_y)
 	const int index = GetWaterRegionIndex(region_x, region_y);
 	WaterRegion water_region(region_x, region_y, _water_region_data[index]);
 	if (!_is_water_region_valid[index]) {
+		const auto start = std::chrono::steady_clock::now();
 		water_region.ForceUpdate();
 		_is_water_region_valid[index] = true;
+
+		const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+		_water_region_rebuild_stats.lazy_rebuilds++;
+		_water_region_rebuild_stats.lazy_time += duration;
+		_water_region_rebuild_stats.max_lazy_time = std::max(_water_region_rebuild_stats.max_lazy_time, duration);
 	}
 	return water_region;
 }
@@ -314,8 +342,11 @@ void InvalidateWaterRegion(TileIndex tile)
 
 	auto invalidate_region = [](TileIndex tile) {
 		const int water_region_index = GetWaterRegionIndex(tile);
-		if (!_is_water_region_valid[water_region_index]) Debug(map, 3, "Invalidated water region ({},{})", GetWaterRegionX(tile), GetWaterRegionY(tile));
+		if (!_is_water_region_valid[water_region_index]) return;
+
+		Debug(map, 3, "Invalidated water region ({},{})", GetWaterRegionX(tile), GetWaterRegionY(tile));
 		_is_water_region_valid[water_region_index] = false;
+		_dirty_water_regions.push_back(water_region_index);
 	};
 
 	invalidate_region(tile);
@@ -362,7 +393,7 @@ static inline void VisitAdjacentWaterRegionPatchNeighbors(const WaterRegionPatch
 	}
 
 	/* Multiple water patches can be reached from the current patch. Check each edge tile individually. */
-	static std::vector<TWaterRegionPatchLabel> unique_labels; // static and vector-instead-of-map for performance reasons
+	static thread_local std::vector<TWaterRegionPatchLabel> unique_labels; // static and vector-instead-of-map for performance reasons, per thread as ship paths are searched in parallel
 	unique_labels.clear();
 	for (int x_or_y = 0; x_or_y < WATER_REGION_EDGE_LENGTH; ++x_or_y) {
 		if (!HasBit(traversability_bits, x_or_y)) continue;
@@ -405,6 +436,67 @@ void VisitWaterRegionPatchNeighbors(const WaterRegionPatchDesc &water_region_pat
 	}
 }
 
+/**
+ * Rebuild the oldest invalidated water regions.
+ * Each water region only writes its own data, so they are rebuilt in parallel.
+ * @param max_regions The maximum number of water regions to rebuild.
+ */
+static void RebuildDirtyWaterRegions(size_t max_regions)
+{
+	std::vector<TWaterRegionIndex> regions;
+	while (!_dirty_water_regions.empty() && regions.size() < max_regions) {
+		const TWaterRegionIndex index = _dirty_water_regions.front();
+		_dirty_water_regions.pop_front();
+		if (!_is_water_region_valid[index]) regions.push_back(index);
+	}
+	if (regions.empty()) return;
+
+	/* A region rebuilt when needed and invalidated again is in the queue twice. */
+	std::sort(regions.begin(), regions.end());
+	regions.erase(std::unique(regions.begin(), regions.end()), regions.end());
+
+	const auto start = std::chrono::steady_clock::now();
+	auto rebuild = [&regions](size_t first, size_t last) {
+		for (size_t i = first; i < last; i++) {
+			const TWaterRegionIndex index = regions[i];
+			WaterRegion(index % GetWaterRegionMapSizeX(), index / GetWaterRegionMapSizeX(), _water_region_data[index]).ForceUpdate();
+		}
+	};
+	if (_settings_client.gui.threaded_game_loop) {
+		ThreadPool::Get().ParallelFor(regions.size(), MIN_PARALLEL_WATER_REGION_REBUILDS, rebuild);
+	} else {
+		rebuild(0, regions.size());
+	}
+
+	/* The validity bits share storage, so they are only written by this thread. */
+	for (const TWaterRegionIndex index : regions) _is_water_region_valid[index] = true;
+
+	_water_region_rebuild_stats.eager_rebuilds += regions.size();
+	_water_region_rebuild_stats.eager_time += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
+
+/**
+ * Rebuild some of the invalidated water regions, so ships do not have to wait for them when they need them.
+ * This is called once per tick and rebuilds at most #MAX_WATER_REGION_REBUILDS_PER_TICK regions.
+ */
+void UpdateDirtyWaterRegions()
+{
+	RebuildDirtyWaterRegions(MAX_WATER_REGION_REBUILDS_PER_TICK);
+}
+
+/**
+ * Updates all water regions that have been invalidated, unless that are more than would be rebuilt in a tick.
+ * Afterwards reading the water regions does not modify them until the next invalidation, so they can be read
+ * from multiple threads.
+ * @return True iff all water regions are valid now.
+ */
+bool TryUpdateAllWaterRegions()
+{
+	if (_dirty_water_regions.size() > MAX_WATER_REGION_REBUILDS_PER_TICK) return false;
+	RebuildDirtyWaterRegions(_dirty_water_regions.size());
+	return true;
+}
+
 /**
  * Allocates the appropriate amount of water regions for the current map size
  */
@@ -418,6 +510,11 @@ void AllocateWaterRegions()
 	_is_water_region_valid.clear();
 	_is_water_region_valid.resize(number_of_regions, false);
 
+	/* All regions start out invalid, so queue them all to be built ahead of time. */
+	_dirty_water_regions.clear();
+	for (int index = 0; index < number_of_regions; index++) _dirty_water_regions.push_back(index);
+	_water_region_rebuild_stats = {};
+
 	Debug(map, 2, "Allocating {} x {} water regions", GetWaterRegionMapSizeX(), GetWaterRegionMapSizeY());
 	assert(_is_water_region_valid.size() == _water_region_data.size());
 }
@@ -425,4 +522,8 @@ void AllocateWaterRegions()
 void PrintWaterRegionDebugInfo(TileIndex tile)
 {
 	GetUpdatedWaterRegion(tile).PrintDebugInfo();
+
+	const WaterRegionRebuildStats &stats = _water_region_rebuild_stats;
+	Debug(map, 2, "Water regions rebuilt ahead of time: {} in {} us; when needed: {} in {} us (max {} us); {} waiting",
+		stats.eager_rebuilds, stats.eager_time.count(), stats.lazy_rebuilds, stats.lazy_time.count(), stats.max_lazy_time.count(), _dirty_water_regions.size());
 }
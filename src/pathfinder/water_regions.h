@@ -59,6 +59,8 @@ WaterRegionDesc GetWaterRegionInfo(TileIndex tile);
 WaterRegionPatchDesc GetWaterRegionPatchInfo(TileIndex tile);
 
 void InvalidateWaterRegion(TileIndex tile);
+void UpdateDirtyWaterRegions();
+bool TryUpdateAllWaterRegions();
 
 using TVisitWaterRegionPatchCallBack = std::function<void(const WaterRegionPatchDesc &)>;
 void VisitWaterRegionPatchNeighbors(const WaterRegionPatchDesc &water_region_patch, TVisitWaterRegionPatchCallBack &callback);
@@ -13,6 +13,125 @@
 #include "../../misc/hashtable.hpp"
 #include "../../misc/binaryheap.hpp"
 
+/**
+ * Storage for the items and the priority queue of a node list.
+ *  Arenas are kept per thread and handed to the next search when a node
+ *  list is done with them. Between searches they are reset instead of
+ *  freed, so the memory for the items and the queue is allocated only
+ *  when a search needs more than any search before it.
+ */
+template <class Titem_>
+class CNodeArenaT {
+public:
+	typedef CBinaryHeapT<Titem_> CPriorityQueue; ///< How the priority queue will be managed.
+
+protected:
+	static const size_t CHUNK_SIZE = 256; ///< Number of items allocated at once.
+	static const size_t MAX_KEPT_ITEMS = 4096; ///< Number of items of which the storage is kept between searches; larger searches free the rest.
+	static const size_t INITIAL_QUEUE_CAPACITY = 2048; ///< Initial number of items the priority queue can hold.
+
+	/** Arenas of this thread that are not used by any node list. */
+	static inline thread_local std::vector<std::unique_ptr<CNodeArenaT>> s_free_arenas;
+
+	std::vector<std::unique_ptr<Titem_[]>> m_chunks; ///< Item storage; items never move, so pointers to them stay valid.
+	size_t          m_num_items;       ///< Number of items handed out since the last reset.
+	size_t          m_allocated_bytes; ///< Number of bytes allocated since the last reset.
+
+public:
+	CPriorityQueue  m_open_queue;      ///< Priority queue of pointers to open item data.
+
+	CNodeArenaT() : m_num_items(0), m_allocated_bytes(0), m_open_queue(INITIAL_QUEUE_CAPACITY)
+	{
+	}
+
+	/**
+	 * Get an arena for a new search, reusing one of a previous search when possible.
+	 * @return The arena, empty.
+	 */
+	static std::unique_ptr<CNodeArenaT> Acquire()
+	{
+		if (s_free_arenas.empty()) return std::make_unique<CNodeArenaT>();
+
+		std::unique_ptr<CNodeArenaT> arena = std::move(s_free_arenas.back());
+		s_free_arenas.pop_back();
+		return arena;
+	}
+
+	/**
+	 * Hand back an arena when its search is done, so it can be reused.
+	 * Storage beyond what common searches need is freed, so one exceptionally
+	 * large search does not keep its memory for the rest of the game.
+	 * @param arena The arena to release.
+	 */
+	static void Release(std::unique_ptr<CNodeArenaT> arena)
+	{
+		arena->m_num_items = 0;
+		arena->m_allocated_bytes = 0;
+		if (arena->m_chunks.size() > MAX_KEPT_ITEMS / CHUNK_SIZE) {
+			arena->m_chunks.resize(MAX_KEPT_ITEMS / CHUNK_SIZE);
+			arena->m_chunks.shrink_to_fit();
+		}
+		if (arena->m_open_queue.Capacity() > MAX_KEPT_ITEMS) {
+			arena->m_open_queue = CPriorityQueue(INITIAL_QUEUE_CAPACITY);
+		} else {
+			arena->m_open_queue.Clear();
+		}
+		s_free_arenas.push_back(std::move(arena));
+	}
+
+	/** allocate new (zeroed) item */
+	inline Titem_ &CreateItem()
+	{
+		if (m_num_items == m_chunks.size() * CHUNK_SIZE) {
+			m_chunks.push_back(std::make_unique<Titem_[]>(CHUNK_SIZE));
+			m_allocated_bytes += CHUNK_SIZE * sizeof(Titem_);
+		}
+		Titem_ &item = m_chunks[m_num_items / CHUNK_SIZE][m_num_items % CHUNK_SIZE];
+		item = Titem_();
+		m_num_items++;
+		return item;
+	}
+
+	/** return number of items handed out since the last reset */
+	inline size_t Count() const
+	{
+		return m_num_items;
+	}
+
+	/** return number of bytes allocated since the last reset, including the growth of the queue */
+	inline size_t AllocatedBytes() const
+	{
+		return m_allocated_bytes;
+	}
+
+	/** Tell the arena the priority queue might have grown. */
+	inline void QueueGrown(size_t old_capacity)
+	{
+		m_allocated_bytes += (m_open_queue.Capacity() - old_capacity) * sizeof(Titem_ *);
+	}
+
+	/** Get a particular item. */
+	inline Titem_ &ItemAt(size_t idx)
+	{
+		return m_chunks[idx / CHUNK_SIZE][idx % CHUNK_SIZE];
+	}
+
+	/** Get a particular item. */
+	inline const Titem_ &ItemAt(size_t idx) const
+	{
+		return m_chunks[idx / CHUNK_SIZE][idx % CHUNK_SIZE];
+	}
+
+	/** Helper for creating output of this array. */
+	template <class D> void Dump(D &dmp) const
+	{
+		dmp.WriteValue("num_items", std::to_string(m_num_items));
+		for (size_t i = 0; i < m_num_items; i++) {
+			dmp.WriteStructT(fmt::format("item[{}]", i), &ItemAt(i));
+		}
+	}
+};
+
 /**
  * Hash table based node list multi-container class.
  *  Implements open list, closed list and priority queue for A-star
@@ -23,21 +142,21 @@ class CNodeList_HashTableT {
 public:
 	typedef Titem_ Titem;                                        ///< Make #Titem_ visible from outside of class.
 	typedef typename Titem_::Key Key;                            ///< Make Titem_::Key a property of this class.
-	using CItemArray = std::deque<Titem_>;                       ///< Type that we will use as item container.
+	typedef CNodeArenaT<Titem_> CItemArena;                      ///< Where we store full item data (Titem_) and the priority queue.
 	typedef CHashTableT<Titem_, Thash_bits_open_  > COpenList;   ///< How pointers to open nodes will be stored.
 	typedef CHashTableT<Titem_, Thash_bits_closed_> CClosedList; ///< How pointers to closed nodes will be stored.
-	typedef CBinaryHeapT<Titem_> CPriorityQueue;                 ///< How the priority queue will be managed.
+	typedef typename CItemArena::CPriorityQueue CPriorityQueue;  ///< How the priority queue will be managed.
 
 protected:
-	CItemArray      m_arr;        ///< Here we store full item data (Titem_).
+	std::unique_ptr<CItemArena> m_arena; ///< Here we store full item data (Titem_) and the priority queue, reused between searches.
 	COpenList       m_open;       ///< Hash table of pointers to open item data.
 	CClosedList     m_closed;     ///< Hash table of pointers to closed item data.
-	CPriorityQueue  m_open_queue; ///< Priority queue of pointers to open item data.
+	CPriorityQueue &m_open_queue; ///< Priority queue of pointers to open item data.
 	Titem          *m_new_node;   ///< New open node under construction.
 
 public:
 	/** default constructor */
-	CNodeList_HashTableT() : m_open_queue(2048)
+	CNodeList_HashTableT() : m_arena(CItemArena::Acquire()), m_open_queue(m_arena->m_open_queue)
 	{
 		m_new_node = nullptr;
 	}
@@ -45,6 +164,13 @@ public:
 	/** destructor */
 	~CNodeList_HashTableT()
 	{
+		CItemArena::Release(std::move(m_arena));
+	}
+
+	/** return number of bytes this node list had to allocate */
+	inline size_t AllocatedBytes() const
+	{
+		return m_arena->AllocatedBytes();
 	}
 
 	/** return number of open nodes */
@@ -62,7 +188,7 @@ public:
 	/** allocate new data item from m_arr */
 	inline Titem_ *CreateNewNode()
 	{
-		if (m_new_node == nullptr) m_new_node = &m_arr.emplace_back();
+		if (m_new_node == nullptr) m_new_node = &m_arena->CreateItem();
 		return m_new_node;
 	}
 
@@ -81,7 +207,9 @@ public:
 	{
 		assert(m_closed.Find(item.GetKey()) == nullptr);
 		m_open.Push(item);
+		const size_t capacity = m_open_queue.Capacity();
 		m_open_queue.Include(&item);
+		if (m_open_queue.Capacity() != capacity) m_arena->QueueGrown(capacity);
 		if (&item == m_new_node) {
 			m_new_node = nullptr;
 		}
@@ -140,19 +268,19 @@ public:
 	/** The number of items. */
 	inline int TotalCount()
 	{
-		return m_arr.Length();
+		return static_cast<int>(m_arena->Count());
 	}
 
 	/** Get a particular item. */
 	inline Titem_ &ItemAt(int idx)
 	{
-		return m_arr[idx];
+		return m_arena->ItemAt(idx);
 	}
 
 	/** Helper for creating output of this array. */
 	template <class D> void Dump(D &dmp) const
 	{
-		dmp.WriteStructT("m_arr", &m_arr);
+		dmp.WriteStructT("m_arr", m_arena.get());
 	}
 };
 
@@ -26,6 +26,20 @@
  */
 Track YapfShipChooseTrack(const Ship *v, TileIndex tile, bool &path_found, ShipPathCache &path_cache);
 
+/** Path search for a ship that is done together with the searches of other ships. */
+struct YapfShipPathRequest {
+	const Ship *v;      ///< The ship, about to leave its tile in the direction of its current track.
+	TileIndex tile;     ///< The tile the ship is about to enter.
+	bool path_found;    ///< [out] Whether a path has been found (true) or has been guessed (false).
+	ShipPathCache path; ///< [out] Trackdirs to follow, starting with the one on  tile.
+};
+
+/**
+ * Finds the best paths for multiple ships using YAPF, spreading the searches over multiple threads.
+ * @param requests The ships to find a path for.
+ */
+void YapfShipChooseTracks(std::vector<YapfShipPathRequest> &requests);
+
 /**
  * Returns true if it is better to reverse the ship before leaving depot using YAPF.
  * @param v the ship leaving the depot
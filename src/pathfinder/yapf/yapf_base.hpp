@@ -64,6 +64,7 @@ protected:
 
 	int                  m_stats_cost_calcs;   ///< stats - how many node's costs were calculated
 	int                  m_stats_cache_hits;   ///< stats - how many node's costs were reused from cache
+	int                  m_stats_nodes_expanded; ///< stats - how many nodes were followed
 
 public:
 	int                  m_num_steps;          ///< this is there for debugging purposes (hope it doesn't hurt)
@@ -78,6 +79,7 @@ public:
 		, m_veh(nullptr)
 		, m_stats_cost_calcs(0)
 		, m_stats_cache_hits(0)
+		, m_stats_nodes_expanded(0)
 		, m_num_steps(0)
 	{
 	}
@@ -99,6 +101,18 @@ public:
 		return *m_settings;
 	}
 
+	/** limit the number of nodes the next search is allowed to visit */
+	inline void SetMaxSearchNodes(int max_search_nodes)
+	{
+		m_max_search_nodes = max_search_nodes;
+	}
+
+	/** return true if the last search gave up because it visited the maximum number of nodes */
+	inline bool HasReachedSearchLimit()
+	{
+		return m_max_search_nodes != 0 && m_nodes.ClosedCount() >= m_max_search_nodes;
+	}
+
 	/**
 	 * Main pathfinder routine:
 	 *   - set startup node(s)
@@ -125,6 +139,7 @@ public:
 			}
 
 			Yapf().PfFollowNode(*best_open_node);
+			m_stats_nodes_expanded++;
 			if (m_max_search_nodes != 0 && m_nodes.ClosedCount() >= m_max_search_nodes) break;
 
 			m_nodes.PopOpenNode(best_open_node->GetKey());
@@ -140,8 +155,8 @@ public:
 			const int cost = destination_found ? m_pBestDestNode->m_cost : -1;
 			const int dist = destination_found ? m_pBestDestNode->m_estimate - m_pBestDestNode->m_cost : -1;
 
-			Debug(yapf, 3, "[YAPF{}]{}{:4d} - {} rounds - {} open - {} closed - CHR {:4.1f}% - C {} D {}",
-				ttc, destination_found ? '-' : '!', veh_idx, m_num_steps, m_nodes.OpenCount(), m_nodes.ClosedCount(), cache_hit_ratio, cost, dist
+			Debug(yapf, 3, "[YAPF{}]{}{:4d} - {} rounds - {} expanded - {} open - {} closed - {} bytes allocated - CHR {:4.1f}% - C {} D {}",
+				ttc, destination_found ? '-' : '!', veh_idx, m_num_steps, m_stats_nodes_expanded, m_nodes.OpenCount(), m_nodes.ClosedCount(), m_nodes.AllocatedBytes(), cache_hit_ratio, cost, dist
 			);
 		}
 
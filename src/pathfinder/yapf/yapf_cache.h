@@ -19,4 +19,10 @@
  */
 void YapfNotifyTrackLayoutChange(TileIndex tile, Track track);
 
+/**
+ * Use this function to notify YAPF that road layout has changed.
+ * @param tile the tile that is changed, or INVALID_TILE when road anywhere might have changed
+ */
+void YapfNotifyRoadLayoutChange(TileIndex tile);
+
 #endif /* YAPF_CACHE_H */
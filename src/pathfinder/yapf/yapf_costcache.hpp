@@ -36,18 +36,51 @@ public:
 
 /**
  * Base class for segment cost cache providers. Contains global counter
- *  of track layout changes and static notification function called whenever
- *  the track layout changes. It is implemented as base class because it needs
- *  to be shared between all rail YAPF types (one shared counter, one notification
+ *  of changes that invalidate everything, the tiles of which the track layout
+ *  changed and static notification function called whenever the track layout
+ *  changes. It is implemented as base class because it needs to be shared
+ *  between all rail YAPF types (one shared counter, one notification
  *  function.
  */
 struct CSegmentCostCacheBase
 {
+	static const size_t C_MAX_CHANGED_TILES = 256; ///< above this number of changed tiles flushing everything is cheaper than checking every segment
+
 	static int   s_rail_change_counter;
+	static std::vector<CSegmentCostCacheBase *> s_caches; ///< all caches, to be told about changed tiles
+
+	std::vector<TileIndex> m_changed_tiles; ///< tiles of which the track layout changed since the cache was last used
+	bool m_flush_all = false;               ///< too many tiles changed since the cache was last used, so flush it completely
+
+	CSegmentCostCacheBase()
+	{
+		s_caches.push_back(this);
+	}
 
-	static void NotifyTrackLayoutChange(TileIndex, Track)
+	~CSegmentCostCacheBase()
+	{
+		std::erase(s_caches, this);
+	}
+
+	/**
+	 * Tell the caches the track layout changed.
+	 * @param tile Tile where the track layout changed, or INVALID_TILE to invalidate everything.
+	 */
+	static void NotifyTrackLayoutChange(TileIndex tile, Track)
 	{
-		s_rail_change_counter++;
+		if (tile == INVALID_TILE) {
+			s_rail_change_counter++;
+			return;
+		}
+		for (CSegmentCostCacheBase *cache : s_caches) {
+			if (cache->m_flush_all) continue;
+			if (cache->m_changed_tiles.size() >= C_MAX_CHANGED_TILES) {
+				cache->m_changed_tiles.clear();
+				cache->m_flush_all = true;
+				continue;
+			}
+			cache->m_changed_tiles.push_back(tile);
+		}
 	}
 };
 
@@ -80,6 +113,22 @@ struct CSegmentCostCacheT : public CSegmentCostCacheBase {
 	{
 		m_map.Clear();
 		m_heap.clear();
+		m_changed_tiles.clear();
+		m_flush_all = false;
+	}
+
+	/** forget the cost of the segments that might depend on the tiles of which the track layout changed */
+	inline void Invalidate()
+	{
+		if (m_flush_all) {
+			Flush();
+			return;
+		}
+		if (m_changed_tiles.empty()) return;
+		for (Tsegment &segment : m_heap) {
+			segment.InvalidateIfAffected(m_changed_tiles);
+		}
+		m_changed_tiles.clear();
 	}
 
 	inline Tsegment &Get(Key &key, bool *found)
@@ -133,6 +182,9 @@ protected:
 		if (last_rail_change_counter != Cache::s_rail_change_counter) {
 			last_rail_change_counter = Cache::s_rail_change_counter;
 			C.Flush();
+		} else {
+			/* ...but usually only the segments near changed tiles */
+			C.Invalidate();
 		}
 		return C;
 	}
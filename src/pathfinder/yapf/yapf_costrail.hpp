@@ -279,6 +279,8 @@ public:
 		CachedData &segment = *n.m_segment;
 		bool is_cached_segment = (segment.m_cost >= 0);
 
+		if (is_cached_segment && _debug_desync_level >= 2) Yapf().CheckCachedSegment(n, tf);
+
 		int parent_cost = has_parent ? n.m_parent->m_cost : 0;
 
 		/* Each node cost contains 2 or 3 main components:
@@ -321,6 +323,9 @@ public:
 
 		EndSegmentReasonBits end_segment_reason = ESRB_NONE;
 
+		/* All tiles the segment passes and the tile after it, for invalidating the cached segment. */
+		TileArea segment_area;
+
 		TrackFollower tf_local(v, Yapf().GetCompatibleRailTypes());
 
 		if (!has_parent) {
@@ -369,6 +374,8 @@ public:
 
 no_entry_cost: // jump here at the beginning if the node has no parent (it is the first node)
 
+			segment_area.Add(cur.tile);
+
 			/* All other tile costs will be calculated here. */
 			segment_cost += Yapf().OneTileCost(cur.tile, cur.td);
 
@@ -496,6 +503,8 @@ no_entry_cost: // jump here at the beginning if the node has no parent (it is th
 				break;
 			}
 
+			segment_area.Add(tf_local.m_new_tile);
+
 			/* Check if the next tile is not a choice. */
 			if (KillFirstBit(tf_local.m_new_td_bits) != TRACKDIR_BIT_NONE) {
 				/* More than one segment will follow. Close this one. */
@@ -567,6 +576,8 @@ no_entry_cost: // jump here at the beginning if the node has no parent (it is th
 			/* Write back the segment information so it can be reused the next time. */
 			segment.m_cost = segment_cost;
 			segment.m_end_segment_reason = end_segment_reason & ESRB_CACHED_MASK;
+			/* Tiles next to the segment decide where it ends, e.g. when track is built there. */
+			segment.m_area = segment_area.Expand(1);
 			/* Save end of segment back to the node. */
 			n.SetLastTileTrackdir(cur.tile, cur.td);
 		}
@@ -609,6 +620,31 @@ no_entry_cost: // jump here at the beginning if the node has no parent (it is th
 		return true;
 	}
 
+	/**
+	 * Check whether a cached segment still matches the map by calculating it again.
+	 * A segment that is not invalidated when the map changes makes trains choose
+	 * other paths than on clients that joined later, with an empty cache.
+	 * @param n Node connected to the cached segment.
+	 * @param tf Track follower that moved to the node.
+	 */
+	void CheckCachedSegment(const Node &n, const TrackFollower *tf)
+	{
+		/* Signals before the segment could prune branches of the search; cached segments are always further away. */
+		if (n.m_parent->m_num_signals_passed == 0) return;
+
+		const CachedData &cached = *n.m_segment;
+		CachedData fresh(cached.m_key);
+		Node check = n;
+		this->ConnectNodeToCachedData(check, fresh);
+		if (!Yapf().PfCalcCost(check, tf) && fresh.m_cost < 0) return;
+
+		if (fresh.m_cost != cached.m_cost || fresh.m_end_segment_reason != cached.m_end_segment_reason || fresh.m_last_tile != cached.m_last_tile || fresh.m_last_td != cached.m_last_td) {
+			Debug(desync, 2, "warning: rail segment cache mismatch at {} {}: cost {} vs {}, end {} vs {}, last tile {} vs {}",
+					cached.m_key.GetTile(), cached.m_key.GetTrackdir(), cached.m_cost, fresh.m_cost,
+					static_cast<uint>(cached.m_end_segment_reason), static_cast<uint>(fresh.m_end_segment_reason), cached.m_last_tile, fresh.m_last_tile);
+		}
+	}
+
 	inline bool CanUseGlobalCache(Node &n) const
 	{
 		return !m_disable_cache
@@ -629,6 +665,11 @@ no_entry_cost: // jump here at the beginning if the node has no parent (it is th
 	{
 		m_disable_cache = disable;
 	}
+
+	inline bool IsCacheDisabled() const
+	{
+		return m_disable_cache;
+	}
 };
 
 #endif /* YAPF_COSTRAIL_HPP */
@@ -163,6 +163,12 @@ public:
 		CYapfDestinationRailBase::SetDestination(v);
 	}
 
+	/** Get the tile the search heads for, or INVALID_TILE when any depot will do. */
+	inline TileIndex GetDestinationTile() const
+	{
+		return m_any_depot ? INVALID_TILE : m_destTile;
+	}
+
 	/** Called by YAPF to detect if node ends in the desired destination */
 	inline bool PfDetectDestination(Node &n)
 	{
@@ -69,6 +69,7 @@ struct CYapfRailSegment
 	TileIndex              m_last_signal_tile;
 	Trackdir               m_last_signal_td;
 	EndSegmentReasonBits   m_end_segment_reason;
+	TileArea               m_area;
 	CYapfRailSegment      *m_hash_next;
 
 	inline CYapfRailSegment(const CYapfRailSegmentKey &key)
@@ -79,9 +80,31 @@ struct CYapfRailSegment
 		, m_last_signal_tile(INVALID_TILE)
 		, m_last_signal_td(INVALID_TRACKDIR)
 		, m_end_segment_reason(ESRB_NONE)
+		, m_area()
 		, m_hash_next(nullptr)
 	{}
 
+	/**
+	 * Forget the cached cost when the segment might pass, or end next to, one of the given tiles.
+	 * @param tiles Tiles of which the track layout changed.
+	 */
+	inline void InvalidateIfAffected(const std::vector<TileIndex> &tiles)
+	{
+		if (m_cost < 0) return;
+		for (TileIndex tile : tiles) {
+			if (!m_area.Contains(tile)) continue;
+
+			m_last_tile = INVALID_TILE;
+			m_last_td = INVALID_TRACKDIR;
+			m_cost = -1;
+			m_last_signal_tile = INVALID_TILE;
+			m_last_signal_td = INVALID_TRACKDIR;
+			m_end_segment_reason = ESRB_NONE;
+			m_area = TileArea();
+			return;
+		}
+	}
+
 	inline const Key &GetKey() const
 	{
 		return m_key;
@@ -14,6 +14,9 @@
 #include "yapf_node_rail.hpp"
 #include "yapf_costrail.hpp"
 #include "yapf_destrail.hpp"
+#include "../rail_regions.h"
+#include "../../signal_func.h"
+#include "../../train.h"
 #include "../../viewport_func.h"
 #include "../../newgrf_station.h"
 
@@ -76,6 +79,7 @@ private:
 		do {
 			if (HasStationReservation(tile)) return false;
 			SetRailStationReservation(tile, true);
+			InvalidateReservationCache(tile);
 			MarkTileDirtyByTile(tile);
 			tile = TileAdd(tile, diff);
 		} while (IsCompatibleTrainStationTile(tile, start) && tile != m_origin_tile);
@@ -114,6 +118,7 @@ private:
 			TileIndexDiff diff = TileOffsByDiagDir(TrackdirToExitdir(ReverseTrackdir(td)));
 			while ((tile != m_res_fail_tile || td != m_res_fail_td) && IsCompatibleTrainStationTile(tile, start)) {
 				SetRailStationReservation(tile, false);
+				InvalidateReservationCache(tile);
 				tile = TileAdd(tile, diff);
 			}
 		} else if (tile != m_res_fail_tile || td != m_res_fail_td) {
@@ -178,7 +183,8 @@ public:
 		if (target != nullptr) target->okay = true;
 
 		if (Yapf().CanUseGlobalCache(*m_res_node)) {
-			YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
+			/* Reserving changes the cost of the segments, but not the track layout, so the rail regions stay valid. */
+			CSegmentCostCacheBase::NotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
 		}
 
 		return true;
@@ -369,6 +375,8 @@ public:
 	typedef typename Node::Key Key;                      ///< key to hash tables
 
 protected:
+	std::vector<TRailRegionIndex> m_corridor; ///< sorted rail regions the search is limited to, or empty to search everywhere
+
 	/** to access inherited path finder */
 	inline Tpf &Yapf()
 	{
@@ -385,6 +393,7 @@ public:
 	{
 		TrackFollower F(Yapf().GetVehicle());
 		if (F.Follow(old_node.GetLastTile(), old_node.GetLastTrackdir())) {
+			if (!m_corridor.empty() && !std::binary_search(m_corridor.begin(), m_corridor.end(), GetRailRegionIndex(F.m_new_tile))) return;
 			Yapf().AddMultipleNodes(&old_node, F);
 		}
 	}
@@ -417,7 +426,7 @@ public:
 		return result1;
 	}
 
-	inline Trackdir ChooseRailTrack(const Train *v, TileIndex, DiagDirection, TrackBits, bool &path_found, bool reserve_track, PBSTileInfo *target, TileIndex *dest)
+	inline Trackdir ChooseRailTrack(const Train *v, TileIndex tile, DiagDirection enterdir, TrackBits tracks, bool &path_found, bool reserve_track, PBSTileInfo *target, TileIndex *dest)
 	{
 		if (target != nullptr) target->tile = INVALID_TILE;
 		if (dest != nullptr) *dest = INVALID_TILE;
@@ -430,6 +439,25 @@ public:
 		/* find the best path */
 		path_found = Yapf().FindPath(v);
 
+		/* The search gave up before reaching the destination, which happens on long and branchy routes.
+		 * Try again, only following tracks in the rail regions on the way to the destination. The corridor
+		 * only holds a fraction of the tracks, so half the node budget suffices and bounds the extra work. */
+		if (!path_found && m_corridor.empty() && Yapf().HasReachedSearchLimit() && Yapf().GetDestinationTile() != INVALID_TILE) {
+			std::vector<TRailRegionIndex> corridor = FindRailRegionCorridor(origin.tile, Yapf().GetDestinationTile());
+			if (!corridor.empty()) {
+				Tpf pf;
+				pf.m_corridor = std::move(corridor);
+				pf.DisableCache(Yapf().IsCacheDisabled());
+				pf.SetMaxSearchNodes(std::max<int>(1, Yapf().PfGetSettings().max_search_nodes / 2));
+				bool corridor_path_found;
+				Trackdir corridor_trackdir = pf.ChooseRailTrack(v, tile, enterdir, tracks, corridor_path_found, reserve_track, target, dest);
+				if (corridor_path_found) {
+					path_found = true;
+					return corridor_trackdir;
+				}
+			}
+		}
+
 		/* if path not found - return INVALID_TRACKDIR */
 		Trackdir next_trackdir = INVALID_TRACKDIR;
 		Node *pNode = Yapf().GetBestNode();
@@ -643,10 +671,20 @@ bool YapfTrainFindNearestSafeTile(const Train *v, TileIndex tile, Trackdir td, b
 	return pfnFindNearestSafeTile(v, tile, td, override_railtype);
 }
 
-/** if any track changes, this counter is incremented - that will invalidate segment cost cache */
+/** if the whole segment cost cache has to be invalidated, this counter is incremented */
 int CSegmentCostCacheBase::s_rail_change_counter = 0;
+/** all segment cost caches; they are told about the tiles where the track layout changes */
+std::vector<CSegmentCostCacheBase *> CSegmentCostCacheBase::s_caches;
 
 void YapfNotifyTrackLayoutChange(TileIndex tile, Track track)
 {
 	CSegmentCostCacheBase::NotifyTrackLayoutChange(tile, track);
+	if (tile == INVALID_TILE) {
+		InvalidateAllRailRegions();
+	} else {
+		InvalidateRailRegion(tile);
+		InvalidateReservationCache(tile);
+		InvalidateSignalSegments(tile);
+		InvalidateTrainFreeRuns();
+	}
 }
@@ -10,10 +10,169 @@
 #include "../../stdafx.h"
 #include "yapf.hpp"
 #include "yapf_node_road.hpp"
+#include "yapf_cache.h"
+#include "../road_regions.h"
 #include "../../roadstop_base.h"
+#include "../../misc/lrucache.hpp"
 
 #include "../../safeguards.h"
 
+/** The occupancy of a road stop, as seen by a path search. */
+struct RoadStopOccupancy {
+	TileIndex tile;    ///< Tile of the road stop.
+	DiagDirection dir; ///< Direction of the entry of a drive-through stop, or INVALID_DIAGDIR for a bay stop.
+	int occupied;      ///< Occupied length of the entry, or bitmask of the occupied bays.
+
+	bool operator==(const RoadStopOccupancy &) const = default;
+	bool operator<(const RoadStopOccupancy &other) const
+	{
+		return std::tie(this->tile, this->dir, this->occupied) < std::tie(other.tile, other.dir, other.occupied);
+	}
+};
+
+/**
+ * Get the occupancy of a road stop.
+ * @param tile Tile of the road stop.
+ * @param dir Direction of the entry of a drive-through stop, or INVALID_DIAGDIR for a bay stop.
+ * @return Occupied length of the entry, or bitmask of the occupied bays.
+ */
+static int GetRoadStopOccupancy(TileIndex tile, DiagDirection dir)
+{
+	const RoadStop *rs = RoadStop::GetByTile(tile, GetRoadStopType(tile));
+	if (dir != INVALID_DIAGDIR) return rs->GetEntry(dir)->GetOccupied();
+	return (rs->IsFreeBay(0) ? 0 : 1) | (rs->IsFreeBay(1) ? 0 : 2);
+}
+
+/** Number of road vehicle path search results to remember. */
+static const size_t ROAD_PATH_RESULT_CACHE_SIZE = 1024;
+
+/** Everything about a road vehicle a path search depends on, besides the map itself. */
+struct RoadPathResultKey {
+	TileIndex tile;             ///< Tile the vehicle is about to enter.
+	DiagDirection enterdir;     ///< Direction the tile is entered in.
+	TileIndex vehicle_tile;     ///< Tile the vehicle is on.
+	TileIndex dest_tile;        ///< Destination tile of the vehicle.
+	TileIndex search_dest_tile; ///< Tile the search heads for; for stations this depends on the current station layout.
+	OrderType order_type;       ///< Type of the current order.
+	DestinationID order_dest;   ///< Destination of the current order.
+	RoadType roadtype;          ///< Road type of the vehicle.
+	Owner owner;                ///< Owner of the vehicle.
+	bool is_bus;                ///< Whether the vehicle is a bus.
+	bool is_articulated;        ///< Whether the vehicle has articulated parts.
+	int max_speed;              ///< Maximum speed of the vehicle for the current order.
+
+	bool operator==(const RoadPathResultKey &) const = default;
+};
+
+template <>
+struct std::hash<RoadPathResultKey> {
+	size_t operator()(const RoadPathResultKey &key) const
+	{
+		size_t hash = key.tile.base();
+		hash = hash * 31 + key.search_dest_tile.base();
+		hash = hash * 31 + key.vehicle_tile.base();
+		hash = hash * 31 + key.enterdir;
+		return hash;
+	}
+};
+
+/** Outcome of a road vehicle path search. */
+struct RoadPathResult {
+	Trackdir trackdir;                         ///< Trackdir to take on the tile.
+	bool path_found;                           ///< Whether the destination was reached.
+	RoadVehPathCache path;                     ///< The path further on.
+	std::vector<RoadStopOccupancy> road_stops; ///< Occupancy of the road stops the search looked at.
+	std::vector<TRoadRegionIndex> regions;     ///< Sorted road regions of the tiles the search looked at.
+	bool all_regions;                          ///< Whether the search depended on the roads in all regions, e.g. via its corridor.
+	uint64_t changes;                          ///< Number of road layout changes when the search was done.
+};
+
+/**
+ * Cache of recent road vehicle path search results, so that vehicles with the same origin and destination
+ * do not repeat the same search. A result is only returned when a new search would come to the same
+ * conclusion: the roads did not change, the pathfinder settings are the same and all road stops the
+ * search looked at are occupied exactly as before. Everything else the search depends on is in the key.
+ *
+ * Road changes are tracked per road region, so a change only drops the results of searches that looked
+ * at the region of the changed tile or at the regions next to it. A search can only start to use a
+ * changed tile via a tile next to it, so that covers new roads as well as removed ones.
+ */
+class RoadPathResultCache {
+	LRUCache<RoadPathResultKey, RoadPathResult> cache{ROAD_PATH_RESULT_CACHE_SIZE};
+	YAPFSettings settings{}; ///< Settings the cached results were found with.
+	std::unordered_map<TRoadRegionIndex, uint64_t> region_changes; ///< Number of road layout changes at the last change of each changed region.
+	uint64_t changes = 0; ///< Number of road layout changes since the cache was flushed.
+
+public:
+	~RoadPathResultCache()
+	{
+		this->Flush();
+	}
+
+	/**
+	 * Find a still valid search result.
+	 * @param key The vehicle searching.
+	 * @return The result, or nullptr when there is no valid result.
+	 */
+	const RoadPathResult *Find(const RoadPathResultKey &key)
+	{
+		if (this->settings != _settings_game.pf.yapf) {
+			this->Flush();
+			this->settings = _settings_game.pf.yapf;
+		}
+		if (!this->cache.Contains(key)) return nullptr;
+
+		const RoadPathResult *result = this->cache.Get(key);
+		if (result->all_regions) {
+			if (result->changes != this->changes) return nullptr;
+		} else {
+			for (const TRoadRegionIndex region : result->regions) {
+				auto it = this->region_changes.find(region);
+				if (it != this->region_changes.end() && it->second > result->changes) return nullptr;
+			}
+		}
+		for (const RoadStopOccupancy &road_stop : result->road_stops) {
+			if (GetRoadStopOccupancy(road_stop.tile, road_stop.dir) != road_stop.occupied) return nullptr;
+		}
+		return result;
+	}
+
+	/**
+	 * Remember a search result, replacing any older result for the same key.
+	 * @param key The vehicle searching.
+	 * @param result The result; the cache takes ownership.
+	 */
+	void Insert(const RoadPathResultKey &key, RoadPathResult *result)
+	{
+		result->changes = this->changes;
+		delete this->cache.Insert(key, result);
+	}
+
+	/**
+	 * Forget the search results that might depend on the road layout of a tile.
+	 * @param tile The tile whose road layout changed.
+	 */
+	void Invalidate(TileIndex tile)
+	{
+		this->changes++;
+		this->region_changes[GetRoadRegionIndex(tile)] = this->changes;
+		for (DiagDirection dir = DIAGDIR_BEGIN; dir != DIAGDIR_END; dir++) {
+			TileIndex neighbour = AddTileIndexDiffCWrap(tile, TileIndexDiffCByDiagDir(dir));
+			if (neighbour != INVALID_TILE) this->region_changes[GetRoadRegionIndex(neighbour)] = this->changes;
+		}
+	}
+
+	/** Forget all search results. */
+	void Flush()
+	{
+		for (RoadPathResult *result = this->cache.Pop(); result != nullptr; result = this->cache.Pop()) delete result;
+		this->region_changes.clear();
+		this->changes = 0;
+	}
+};
+
+static RoadPathResultCache _road_path_result_cache;
+
 
 template <class Types>
 class CYapfCostRoadT
@@ -24,6 +183,11 @@ public:
 	typedef typename Types::NodeList::Titem Node; ///< this will be our node type
 	typedef typename Node::Key Key;    ///< key to hash tables
 
+public:
+	std::vector<RoadStopOccupancy> m_road_stop_reads; ///< occupancy of the road stops that influenced the costs
+	std::vector<TRoadRegionIndex> m_region_reads; ///< road regions of the tiles that influenced the costs
+	bool m_reads_all_regions = false; ///< whether the roads in all regions influenced the search
+
 protected:
 	int m_max_cost;
 
@@ -80,12 +244,15 @@ protected:
 						if (!RoadStop::IsDriveThroughRoadStopContinuation(tile, tile - TileOffsByDiagDir(dir))) {
 							/* When we're the first road stop in a 'queue' of them we increase
 							 * cost based on the fill percentage of the whole queue. */
-							const RoadStop::Entry *entry = rs->GetEntry(dir);
-							cost += entry->GetOccupied() * Yapf().PfGetSettings().road_stop_occupied_penalty / entry->GetLength();
+							const int occupied = GetRoadStopOccupancy(tile, dir);
+							m_road_stop_reads.push_back({ tile, dir, occupied });
+							cost += occupied * Yapf().PfGetSettings().road_stop_occupied_penalty / rs->GetEntry(dir)->GetLength();
 						}
 					} else {
 						/* Increase cost for filled road stops */
-						cost += Yapf().PfGetSettings().road_stop_bay_occupied_penalty * (!rs->IsFreeBay(0) + !rs->IsFreeBay(1)) / 2;
+						const int occupied = GetRoadStopOccupancy(tile, INVALID_DIAGDIR);
+						m_road_stop_reads.push_back({ tile, INVALID_DIAGDIR, occupied });
+						cost += Yapf().PfGetSettings().road_stop_bay_occupied_penalty * CountBits(static_cast<uint>(occupied)) / 2;
 					}
 					break;
 				}
@@ -121,6 +288,10 @@ public:
 		int parent_cost = (n.m_parent != nullptr) ? n.m_parent->m_cost : 0;
 
 		for (;;) {
+			/* remember the road region of the tile for the path result cache */
+			const TRoadRegionIndex region = GetRoadRegionIndex(tile);
+			if (m_region_reads.empty() || m_region_reads.back() != region) m_region_reads.push_back(region);
+
 			/* base tile cost depending on distance between edges */
 			segment_cost += Yapf().OneTileCost(tile, trackdir);
 
@@ -264,6 +435,11 @@ public:
 		return m_dest_station != INVALID_STATION ? Station::GetIfValid(m_dest_station) : nullptr;
 	}
 
+	TileIndex GetDestinationTile() const
+	{
+		return m_destTile;
+	}
+
 protected:
 	/** to access inherited path finder */
 	Tpf &Yapf()
@@ -332,6 +508,8 @@ public:
 	typedef typename Node::Key Key;                      ///< key to hash tables
 
 protected:
+	std::vector<TRoadRegionIndex> m_corridor; ///< sorted road regions the search is limited to, or empty to search everywhere
+
 	/** to access inherited path finder */
 	inline Tpf &Yapf()
 	{
@@ -349,6 +527,7 @@ public:
 	{
 		TrackFollower F(Yapf().GetVehicle());
 		if (F.Follow(old_node.m_segment_last_tile, old_node.m_segment_last_td)) {
+			if (!m_corridor.empty() && !std::binary_search(m_corridor.begin(), m_corridor.end(), GetRoadRegionIndex(F.m_new_tile))) return;
 			Yapf().AddMultipleNodes(&old_node, F);
 		}
 	}
@@ -362,7 +541,44 @@ public:
 	static Trackdir stChooseRoadTrack(const RoadVehicle *v, TileIndex tile, DiagDirection enterdir, bool &path_found, RoadVehPathCache &path_cache)
 	{
 		Tpf pf;
-		return pf.ChooseRoadTrack(v, tile, enterdir, path_found, path_cache);
+		if (!path_cache.empty()) return pf.ChooseRoadTrack(v, tile, enterdir, path_found, path_cache);
+
+		/* Vehicles following each other tend to search for the same path, so try an earlier result first. */
+		pf.SetDestination(v);
+		const RoadPathResultKey key{
+			tile, enterdir, v->tile, v->dest_tile, pf.GetDestinationTile(),
+			v->current_order.GetType(), v->current_order.GetDestination(),
+			v->roadtype, v->owner, v->IsBus(), v->HasArticulatedPart(),
+			std::min<int>(v->GetDisplayMaxSpeed(), v->current_order.GetMaxSpeed() * 2)
+		};
+		const RoadPathResult *cached = _road_path_result_cache.Find(key);
+		if (cached != nullptr && _debug_desync_level < 2) {
+			path_found = cached->path_found;
+			path_cache = cached->path;
+			return cached->trackdir;
+		}
+
+		RoadPathResult *result = new RoadPathResult();
+		result->path_found = true;
+		result->trackdir = pf.ChooseRoadTrack(v, tile, enterdir, result->path_found, result->path);
+		result->road_stops = std::move(pf.m_road_stop_reads);
+		std::sort(result->road_stops.begin(), result->road_stops.end());
+		result->road_stops.erase(std::unique(result->road_stops.begin(), result->road_stops.end()), result->road_stops.end());
+		result->regions = std::move(pf.m_region_reads);
+		result->regions.push_back(GetRoadRegionIndex(tile)); // The trackdirs on the first tile are read without a cost.
+		std::sort(result->regions.begin(), result->regions.end());
+		result->regions.erase(std::unique(result->regions.begin(), result->regions.end()), result->regions.end());
+		result->all_regions = pf.m_reads_all_regions;
+
+		if (cached != nullptr && (cached->trackdir != result->trackdir || cached->path_found != result->path_found || cached->path.td != result->path.td || cached->path.tile != result->path.tile)) {
+			Debug(desync, 2, "warning: ChooseRoadTrack cache mismatch: {} vs {}", cached->trackdir, result->trackdir);
+		}
+
+		path_found = result->path_found;
+		path_cache = result->path;
+		const Trackdir trackdir = result->trackdir;
+		_road_path_result_cache.Insert(key, result);
+		return trackdir;
 	}
 
 	inline Trackdir ChooseRoadTrack(const RoadVehicle *v, TileIndex tile, DiagDirection enterdir, bool &path_found, RoadVehPathCache &path_cache)
@@ -389,6 +605,29 @@ public:
 		/* find the best path */
 		path_found = Yapf().FindPath(v);
 
+		/* The search gave up before reaching the destination, which happens in large road networks.
+		 * Try again, only following roads in the road regions on the way to the destination. */
+		if (!path_found && m_corridor.empty() && Yapf().HasReachedSearchLimit()) {
+			/* The corridor depends on the roads everywhere between here and the destination. */
+			Yapf().m_reads_all_regions = true;
+			std::vector<TRoadRegionIndex> corridor = FindRoadRegionCorridor(src_tile, Yapf().GetDestinationTile(), GetRoadTramType(v->roadtype));
+			if (!corridor.empty()) {
+				Tpf pf;
+				pf.m_corridor = std::move(corridor);
+				bool corridor_path_found;
+				Trackdir corridor_trackdir = pf.ChooseRoadTrack(v, tile, enterdir, corridor_path_found, path_cache);
+				Yapf().m_road_stop_reads.insert(Yapf().m_road_stop_reads.end(), pf.m_road_stop_reads.begin(), pf.m_road_stop_reads.end());
+				if (corridor_path_found) {
+					path_found = true;
+					return corridor_trackdir;
+				}
+				path_cache.clear();
+			}
+		}
+
+		/* Paths to far away destinations are unlikely to change soon, so cache more of them. */
+		const uint cache_segments = (path_found && GetRoadRegionDistance(tile, Yapf().GetDestinationTile()) > 1) ? YAPF_ROADVEH_PATH_CACHE_SEGMENTS_DISTANT : YAPF_ROADVEH_PATH_CACHE_SEGMENTS;
+
 		/* if path not found - return INVALID_TRACKDIR */
 		Trackdir next_trackdir = INVALID_TRACKDIR;
 		Node *pNode = Yapf().GetBestNode();
@@ -400,7 +639,7 @@ public:
 			 * walk through the path back to its origin */
 			while (pNode->m_parent != nullptr) {
 				steps--;
-				if (pNode->GetIsChoice() && steps < YAPF_ROADVEH_PATH_CACHE_SEGMENTS) {
+				if (pNode->GetIsChoice() && steps < cache_segments) {
 					path_cache.td.push_front(pNode->GetTrackdir());
 					path_cache.tile.push_front(pNode->GetTile());
 				}
@@ -566,3 +805,14 @@ FindDepotData YapfRoadVehicleFindNearestDepot(const RoadVehicle *v, int max_dist
 
 	return pfnFindNearestDepot(v, tile, trackdir, max_distance);
 }
+
+void YapfNotifyRoadLayoutChange(TileIndex tile)
+{
+	if (tile == INVALID_TILE) {
+		InvalidateAllRoadRegions();
+		_road_path_result_cache.Flush();
+	} else {
+		InvalidateRoadRegion(tile);
+		_road_path_result_cache.Invalidate(tile);
+	}
+}
@@ -16,6 +16,7 @@
 #include "yapf_node_ship.hpp"
 #include "yapf_ship_regions.h"
 #include "../water_regions.h"
+#include "../../thread_pool.h"
 
 #include "../../safeguards.h"
 
@@ -212,12 +213,27 @@ public:
 
 	static Trackdir ChooseShipTrack(const Ship *v, TileIndex tile, TrackdirBits forward_dirs, TrackdirBits reverse_dirs,
 		bool &path_found, ShipPathCache &path_cache, Trackdir &best_origin_dir)
+	{
+		int random_path_length = 0;
+		const Trackdir result = FindShipPath(v, tile, forward_dirs, reverse_dirs, path_found, path_cache, best_origin_dir, random_path_length);
+		if (random_path_length != 0) return CreateRandomPath(v, path_cache, random_path_length);
+		return result;
+	}
+
+	/**
+	 * Search the path for a ship, without drawing random numbers so it can be run on any thread.
+	 * @param random_path_length [out] When not 0, the length of the random path the ship has to follow instead of the found path.
+	 * @see ChooseShipTrack for the other parameters.
+	 */
+	static Trackdir FindShipPath(const Ship *v, TileIndex tile, TrackdirBits forward_dirs, TrackdirBits reverse_dirs,
+		bool &path_found, ShipPathCache &path_cache, Trackdir &best_origin_dir, int &random_path_length)
 	{
 		const std::vector<WaterRegionPatchDesc> high_level_path = YapfShipFindWaterRegionPath(v, tile, NUMBER_OR_WATER_REGIONS_LOOKAHEAD + 1);
 		if (high_level_path.empty()) {
 			path_found = false;
 			/* Make the ship move around aimlessly. This prevents repeated pathfinder calls and clearly indicates that the ship is lost. */
-			return CreateRandomPath(v, path_cache, SHIP_LOST_PATH_LENGTH);
+			random_path_length = SHIP_LOST_PATH_LENGTH;
+			return INVALID_TRACKDIR;
 		}
 
 		/* Try one time without restricting the search area, which generally results in better and more natural looking paths.
@@ -242,7 +258,10 @@ public:
 			if (attempt == 0 && !path_found) continue; // Try again with restricted search area.
 
 			/* Make the ship move around aimlessly. This prevents repeated pathfinder calls and clearly indicates that the ship is lost. */
-			if (!path_found) return CreateRandomPath(v, path_cache, SHIP_LOST_PATH_LENGTH);
+			if (!path_found) {
+				random_path_length = SHIP_LOST_PATH_LENGTH;
+				return INVALID_TRACKDIR;
+			}
 
 			/* Return only the path within the current water region if an intermediate destination was returned. If not, cache the entire path
 			 * to the final destination tile. The low-level pathfinder might actually prefer a different docking tile in a nearby region. Without
@@ -276,7 +295,10 @@ public:
 
 			/* A empty path means we are already at the destination. The pathfinder shouldn't have been called at all.
 			 * Return a random reachable trackdir to hopefully nudge the ship out of this strange situation. */
-			if (path_cache.empty()) return CreateRandomPath(v, path_cache, 1);
+			if (path_cache.empty()) {
+				random_path_length = 1;
+				return INVALID_TRACKDIR;
+			}
 
 			/* Take out the last trackdir as the result. */
 			const Trackdir result = path_cache.front();
@@ -432,6 +454,41 @@ Track YapfShipChooseTrack(const Ship *v, TileIndex tile, bool &path_found, ShipP
 	return (td_ret != INVALID_TRACKDIR) ? TrackdirToTrack(td_ret) : INVALID_TRACK;
 }
 
+void YapfShipChooseTracks(std::vector<YapfShipPathRequest> &requests)
+{
+	if (requests.empty()) return;
+
+	/* The searches only read the map, the vehicles and the water regions, so the latter must not need updating while searching.
+	 * Rebuilding many regions at once, like after loading, would stall this tick. Then the searches run one after another
+	 * and update the regions they need, until UpdateDirtyWaterRegions has caught up. */
+	const bool parallel = _settings_client.gui.threaded_game_loop && TryUpdateAllWaterRegions();
+
+	std::vector<int> random_path_lengths(requests.size(), 0);
+	auto search = [&requests, &random_path_lengths](size_t first, size_t last) {
+		for (size_t i = first; i < last; i++) {
+			YapfShipPathRequest &request = requests[i];
+			Trackdir best_origin_dir = INVALID_TRACKDIR;
+			const TrackdirBits origin_dirs = TrackdirToTrackdirBits(request.v->GetVehicleTrackdir());
+			const Trackdir td = CYapfShip::FindShipPath(request.v, request.tile, origin_dirs, TRACKDIR_BIT_NONE, request.path_found, request.path, best_origin_dir, random_path_lengths[i]);
+			if (td != INVALID_TRACKDIR) request.path.push_front(td);
+		}
+	};
+	if (parallel) {
+		ThreadPool::Get().ParallelFor(requests.size(), 1, search);
+	} else {
+		search(0, requests.size());
+	}
+
+	/* Random paths for lost ships are made afterwards, so the random numbers are drawn in the same order on every client. */
+	for (size_t i = 0; i < requests.size(); i++) {
+		if (random_path_lengths[i] == 0) continue;
+
+		YapfShipPathRequest &request = requests[i];
+		const Trackdir td = CYapfShip::CreateRandomPath(request.v, request.path, random_path_lengths[i]);
+		if (td != INVALID_TRACKDIR) request.path.push_front(td);
+	}
+}
+
 bool YapfShipCheckReverse(const Ship *v, Trackdir *trackdir)
 {
 	return CYapfShip::CheckShipReverse(v, trackdir);
@@ -12,6 +12,7 @@
 #include "vehicle_func.h"
 #include "newgrf_station.h"
 #include "pathfinder/follow_track.hpp"
+#include "debug.h"
 
 #include "safeguards.h"
 
@@ -64,6 +65,7 @@ void SetRailStationPlatformReservation(TileIndex start, DiagDirection dir, bool
 
 	do {
 		SetRailStationReservation(tile, b);
+		InvalidateReservationCache(tile);
 		MarkTileDirtyByTile(tile);
 		tile = TileAdd(tile, diff);
 	} while (IsCompatibleTrainStationTile(tile, start));
@@ -81,6 +83,8 @@ bool TryReserveRailTrack(TileIndex tile, Track t, bool trigger_stations)
 {
 	assert(HasTrack(TrackStatusToTrackBits(GetTileTrackStatus(tile, TRANSPORT_RAIL, 0)), t));
 
+	InvalidateReservationCache(tile);
+
 	if (_settings_client.gui.show_track_reservation) {
 		/* show the reserved rail if needed */
 		if (IsBridgeTile(tile)) {
@@ -141,6 +145,8 @@ void UnreserveRailTrack(TileIndex tile, Track t)
 {
 	assert(HasTrack(TrackStatusToTrackBits(GetTileTrackStatus(tile, TRANSPORT_RAIL, 0)), t));
 
+	InvalidateReservationCache(tile);
+
 	if (_settings_client.gui.show_track_reservation) {
 		if (IsBridgeTile(tile)) {
 			MarkBridgeDirty(tile);
@@ -183,21 +189,168 @@ void UnreserveRailTrack(TileIndex tile, Track t)
 }
 
 
-/** Follow a reservation starting from a specific tile to the end. */
-static PBSTileInfo FollowReservation(Owner o, RailTypes rts, TileIndex tile, Trackdir trackdir, bool ignore_oneway = false)
+/** Edge length of the square areas of the map in which changes to tracks and reservations are counted. */
+static const uint RESERVATION_AREA_EDGE_LENGTH = 4;
+
+static std::vector<uint32_t> _reservation_area_generations; ///< For every area of the map the number of changes to its tracks and reservations.
+static uint32_t _reservation_cache_generation = 0; ///< Incremented whenever all cached reservation walks have to be thrown away.
+
+/**
+ * Get the index of the area of the map a tile is in.
+ * @param tile The tile.
+ * @return Index into #_reservation_area_generations.
+ */
+static inline uint GetReservationAreaIndex(TileIndex tile)
+{
+	return (TileY(tile) / RESERVATION_AREA_EDGE_LENGTH) * (Map::SizeX() / RESERVATION_AREA_EDGE_LENGTH) + TileX(tile) / RESERVATION_AREA_EDGE_LENGTH;
+}
+
+/**
+ * Tell the reservation cache that the reservation or the tracks on a tile have changed.
+ * @param tile The changed tile, or INVALID_TILE when anything on the map might have changed.
+ */
+void InvalidateReservationCache(TileIndex tile)
+{
+	if (tile == INVALID_TILE) {
+		_reservation_area_generations.assign(Map::Size() / (RESERVATION_AREA_EDGE_LENGTH * RESERVATION_AREA_EDGE_LENGTH), 0);
+		_reservation_cache_generation++;
+		return;
+	}
+
+	if (!_reservation_area_generations.empty()) _reservation_area_generations[GetReservationAreaIndex(tile)]++;
+}
+
+/**
+ * A walk along the reservation of a train, kept so the next time the end of the reservation is needed it
+ * does not have to be followed again. Every position passed is remembered, so when the train has moved on
+ * along its reservation the rest of the walk can still be used. For every area of the map the walk looked
+ * at the number of changes is stored; only the part of the walk after a changed area has to be redone.
+ */
+struct CachedReservationWalk {
+	/** An area of the map looked at while following the reservation from some of the positions. */
+	struct AreaStamp {
+		uint area;           ///< Index of the area.
+		uint32_t generation; ///< Number of changes to the area at the time it was looked at.
+		uint first_step;     ///< First position from which the area was looked at.
+		uint last_step;      ///< Last position from which the area was looked at.
+	};
+
+	uint32_t generation = 0;              ///< Value of #_reservation_cache_generation when the walk was started.
+	Owner owner = INVALID_OWNER;          ///< Owner of the followed tracks.
+	RailTypes railtypes = RAILTYPES_NONE; ///< Railtypes the walk could follow.
+	bool reusable = false;                ///< Whether the walk can be reused from a later position; not so when it ended on a loop.
+	std::vector<std::pair<TileIndex, Trackdir>> steps; ///< Positions passed, starting with the start of the walk.
+	std::vector<AreaStamp> stamps;        ///< Areas looked at, ordered by the first position they were looked at from.
+	PBSTileInfo end;                      ///< End of the reservation.
+
+	/**
+	 * Remember that a tile was looked at while following the reservation from the last position.
+	 * @param tile The tile.
+	 */
+	void Stamp(TileIndex tile)
+	{
+		const uint area = GetReservationAreaIndex(tile);
+		const uint step = static_cast<uint>(this->steps.size()) - 1;
+		if (!this->stamps.empty() && this->stamps.back().area == area) {
+			this->stamps.back().last_step = step;
+			return;
+		}
+		this->stamps.push_back({ area, _reservation_area_generations[area], step, step });
+	}
+
+	/**
+	 * Remember the tiles the track follower looked at, whether it succeeded or not.
+	 * @param ft The track follower.
+	 */
+	void Stamp(const CFollowTrackRail &ft)
+	{
+		this->Stamp(ft.m_old_tile);
+		if (ft.m_new_tile == INVALID_TILE) return;
+		if (!ft.m_is_station) {
+			this->Stamp(ft.m_new_tile);
+			return;
+		}
+
+		/* The follower looked at the whole platform and the tile behind it to find its length. */
+		const TileIndexDiff diff = TileOffsByDiagDir(ft.m_exitdir);
+		for (TileIndex tile = ft.m_new_tile - diff * ft.m_tiles_skipped; tile != ft.m_new_tile + diff; tile += diff) {
+			this->Stamp(tile);
+		}
+	}
+
+	/**
+	 * Forget about the positions before the given one, as if the walk had been started there.
+	 * @param step The position to start at.
+	 */
+	void Rebase(uint step)
+	{
+		if (step == 0) return;
+
+		this->steps.erase(this->steps.begin(), this->steps.begin() + step);
+		this->stamps.erase(std::remove_if(this->stamps.begin(), this->stamps.end(), [step](const AreaStamp &stamp) { return stamp.last_step < step; }), this->stamps.end());
+		for (AreaStamp &stamp : this->stamps) {
+			stamp.first_step = std::max(stamp.first_step, step) - step;
+			stamp.last_step -= step;
+		}
+	}
+
+	/**
+	 * Forget about the positions after the first one from which a changed area was looked at.
+	 * @return True when nothing the walk looked at has changed.
+	 */
+	bool Truncate()
+	{
+		auto changed = std::find_if(this->stamps.begin(), this->stamps.end(), [](const AreaStamp &stamp) { return _reservation_area_generations[stamp.area] != stamp.generation; });
+		if (changed == this->stamps.end()) return true;
+
+		const uint step = changed->first_step;
+		this->steps.resize(step + 1);
+		this->stamps.erase(std::find_if(this->stamps.begin(), changed + 1, [step](const AreaStamp &stamp) { return stamp.first_step == step; }), this->stamps.end());
+		for (AreaStamp &stamp : this->stamps) stamp.last_step = std::min(stamp.last_step, step - 1);
+		return false;
+	}
+};
+
+static std::vector<CachedReservationWalk> _cached_reservation_walks; ///< Last reservation walk of every train, indexed by vehicle ID.
+
+/**
+ * Follow a reservation starting from a specific tile to the end.
+ * @param o Owner of the tracks to follow.
+ * @param rts Railtypes that can be followed.
+ * @param tile Start tile.
+ * @param trackdir Start trackdir.
+ * @param ignore_oneway Whether to follow the reservation through one-way signals facing the other way.
+ * @param walk If not \c nullptr, the walk to record the positions and looked at areas in. When it already contains
+ *             positions the follow continues from its last position, as a part of the walk from its first position.
+ * @return The end of the reservation.
+ */
+static PBSTileInfo FollowReservation(Owner o, RailTypes rts, TileIndex tile, Trackdir trackdir, bool ignore_oneway = false, CachedReservationWalk *walk = nullptr)
 {
 	TileIndex start_tile = tile;
 	Trackdir  start_trackdir = trackdir;
 	bool      first_loop = true;
 
-	/* Start track not reserved? This can happen if two trains
-	 * are on the same tile. The reservation on the next tile
-	 * is not ours in this case, so exit. */
-	if (!HasReservedTracks(tile, TrackToTrackBits(TrackdirToTrack(trackdir)))) return PBSTileInfo(tile, trackdir, false);
+	if (walk != nullptr && walk->steps.size() > 1) {
+		/* Continue an earlier walk; loops are detected against its first step. */
+		start_tile = walk->steps[1].first;
+		start_trackdir = walk->steps[1].second;
+		first_loop = false;
+	} else {
+		if (walk != nullptr) walk->Stamp(tile);
+
+		/* Start track not reserved? This can happen if two trains
+		 * are on the same tile. The reservation on the next tile
+		 * is not ours in this case, so exit. */
+		if (!HasReservedTracks(tile, TrackToTrackBits(TrackdirToTrack(trackdir)))) return PBSTileInfo(tile, trackdir, false);
+	}
 
 	/* Do not disallow 90 deg turns as the setting might have changed between reserving and now. */
 	CFollowTrackRail ft(o, rts);
-	while (ft.Follow(tile, trackdir)) {
+	for (;;) {
+		const bool followed = ft.Follow(tile, trackdir);
+		if (walk != nullptr) walk->Stamp(ft);
+		if (!followed) break;
+
 		TrackdirBits reserved = ft.m_new_td_bits & TrackBitsToTrackdirBits(GetReservedTrackbits(ft.m_new_tile));
 
 		/* No reservation --> path end found */
@@ -226,6 +379,7 @@ static PBSTileInfo FollowReservation(Owner o, RailTypes rts, TileIndex tile, Tra
 
 		tile = ft.m_new_tile;
 		trackdir = new_trackdir;
+		if (walk != nullptr) walk->steps.emplace_back(tile, trackdir);
 
 		if (first_loop) {
 			/* Update the start tile after we followed the track the first
@@ -237,7 +391,10 @@ static PBSTileInfo FollowReservation(Owner o, RailTypes rts, TileIndex tile, Tra
 			first_loop = false;
 		} else {
 			/* Loop encountered? */
-			if (tile == start_tile && trackdir == start_trackdir) break;
+			if (tile == start_tile && trackdir == start_trackdir) {
+				if (walk != nullptr) walk->reusable = false;
+				break;
+			}
 		}
 		/* Depot tile? Can't continue. */
 		if (IsRailDepotTile(tile)) break;
@@ -248,6 +405,55 @@ static PBSTileInfo FollowReservation(Owner o, RailTypes rts, TileIndex tile, Tra
 	return PBSTileInfo(tile, trackdir, false);
 }
 
+/**
+ * Follow the reservation of a train to the end, reusing as much as possible of its previous walk.
+ * @param v The train.
+ * @param tile Start tile.
+ * @param trackdir Start trackdir.
+ * @return The end of the reservation.
+ */
+static PBSTileInfo FollowCachedReservation(const Train *v, TileIndex tile, Trackdir trackdir)
+{
+	const Owner o = v->owner;
+	const RailTypes rts = GetRailTypeInfo(v->railtype)->compatible_railtypes;
+	if (_reservation_area_generations.empty()) return FollowReservation(o, rts, tile, trackdir);
+
+	if (v->index >= _cached_reservation_walks.size()) _cached_reservation_walks.resize(v->index + 1);
+	CachedReservationWalk &walk = _cached_reservation_walks[v->index];
+
+	/* The train might have moved on along its reservation since the last walk. */
+	auto start = walk.steps.end();
+	if (walk.generation == _reservation_cache_generation && walk.owner == o && walk.railtypes == rts) {
+		start = std::find(walk.steps.begin(), walk.steps.end(), std::make_pair(tile, trackdir));
+		if (start != walk.steps.begin() && !walk.reusable) start = walk.steps.end();
+	}
+
+	bool valid = false;
+	if (start == walk.steps.end()) {
+		walk.generation = _reservation_cache_generation;
+		walk.owner = o;
+		walk.railtypes = rts;
+		walk.steps.assign(1, std::make_pair(tile, trackdir));
+		walk.stamps.clear();
+	} else {
+		walk.Rebase(static_cast<uint>(start - walk.steps.begin()));
+		valid = walk.Truncate();
+	}
+
+	if (!valid) {
+		walk.reusable = true;
+		walk.end = FollowReservation(o, rts, walk.steps.back().first, walk.steps.back().second, false, &walk);
+	} else if (_debug_desync_level >= 2) {
+		PBSTileInfo res = FollowReservation(o, rts, tile, trackdir);
+		if (res.tile != walk.end.tile || res.trackdir != walk.end.trackdir) {
+			Debug(desync, 2, "warning: FollowTrainReservation cache mismatch: {}/{} vs {}/{}", walk.end.tile, walk.end.trackdir, res.tile, res.trackdir);
+		}
+		walk.end = res;
+	}
+
+	return walk.end;
+}
+
 /**
  * Helper struct for finding the best matching vehicle on a specific track.
  */
@@ -295,7 +501,7 @@ PBSTileInfo FollowTrainReservation(const Train *v, Vehicle **train_on_res)
 	if (IsRailDepotTile(tile) && !GetDepotReservationTrackBits(tile)) return PBSTileInfo(tile, trackdir, false);
 
 	FindTrainOnTrackInfo ftoti;
-	ftoti.res = FollowReservation(v->owner, GetRailTypeInfo(v->railtype)->compatible_railtypes, tile, trackdir);
+	ftoti.res = FollowCachedReservation(v, tile, trackdir);
 	ftoti.res.okay = IsSafeWaitingPosition(v, ftoti.res.tile, ftoti.res.trackdir, true, _settings_game.pf.forbid_90_deg);
 	if (train_on_res != nullptr) {
 		FindVehicleOnPos(ftoti.res.tile, &ftoti, FindTrainOnTrackEnum);
@@ -22,6 +22,8 @@ void SetRailStationPlatformReservation(TileIndex start, DiagDirection dir, bool
 bool TryReserveRailTrack(TileIndex tile, Track t, bool trigger_stations = true);
 void UnreserveRailTrack(TileIndex tile, Track t);
 
+void InvalidateReservationCache(TileIndex tile);
+
 /** This struct contains information about the end of a reserved path. */
 struct PBSTileInfo {
 	TileIndex tile;      ///< Tile the path ends, INVALID_TILE if no valid path was found.
@@ -378,6 +378,8 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlag flags, RoadBits piec
 
 				SetRoadType(other_end, rtt, INVALID_ROADTYPE);
 				SetRoadType(tile,      rtt, INVALID_ROADTYPE);
+				YapfNotifyRoadLayoutChange(other_end);
+				YapfNotifyRoadLayoutChange(tile);
 
 				/* If the owner of the bridge sells all its road, also move the ownership
 				 * to the owner of the other roadtype, unless the bridge owner is a town. */
@@ -402,6 +404,7 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlag flags, RoadBits piec
 				/* A full diagonal road tile has two road bits. */
 				UpdateCompanyRoadInfrastructure(existing_rt, GetRoadOwner(tile, rtt), -2);
 				SetRoadType(tile, rtt, INVALID_ROADTYPE);
+				YapfNotifyRoadLayoutChange(tile);
 				MarkTileDirtyByTile(tile);
 			}
 		}
@@ -456,6 +459,7 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlag flags, RoadBits piec
 				}
 
 				UpdateCompanyRoadInfrastructure(existing_rt, GetRoadOwner(tile, rtt), -(int)CountBits(pieces));
+				YapfNotifyRoadLayoutChange(tile);
 
 				if (present == ROAD_NONE) {
 					/* No other road type, just clear tile. */
@@ -518,6 +522,7 @@ static CommandCost RemoveRoad(TileIndex tile, DoCommandFlag flags, RoadBits piec
 				} else {
 					SetRoadType(tile, rtt, INVALID_ROADTYPE);
 				}
+				YapfNotifyRoadLayoutChange(tile);
 				MarkTileDirtyByTile(tile);
 				YapfNotifyTrackLayoutChange(tile, railtrack);
 			}
@@ -682,6 +687,7 @@ CommandCost CmdBuildRoad(DoCommandFlag flags, TileIndex tile, RoadBits pieces, R
 							if ((flags & DC_EXEC) && IsStraightRoad(existing)) {
 								SetDisallowedRoadDirections(tile, dis_new);
 								MarkTileDirtyByTile(tile);
+								YapfNotifyRoadLayoutChange(tile);
 							}
 							return CommandCost();
 						}
@@ -782,6 +788,7 @@ CommandCost CmdBuildRoad(DoCommandFlag flags, TileIndex tile, RoadBits pieces, R
 				SetCrossingReservation(tile, reserved);
 				UpdateLevelCrossing(tile, false);
 				MarkDirtyAdjacentLevelCrossingTiles(tile, GetCrossingRoadAxis(tile));
+				YapfNotifyRoadLayoutChange(tile);
 				MarkTileDirtyByTile(tile);
 			}
 			return CommandCost(EXPENSES_CONSTRUCTION, 2 * RoadBuildCost(rt));
@@ -902,6 +909,7 @@ do_clear:;
 				SetRoadType(tile, rtt, rt);
 				SetRoadOwner(other_end, rtt, company);
 				SetRoadOwner(tile, rtt, company);
+				YapfNotifyRoadLayoutChange(other_end);
 
 				/* Mark tiles dirty that have been repaved */
 				if (IsBridge(tile)) {
@@ -925,6 +933,8 @@ do_clear:;
 				break;
 		}
 
+		YapfNotifyRoadLayoutChange(tile);
+
 		/* Update company infrastructure count. */
 		if (IsTileType(tile, MP_TUNNELBRIDGE)) num_pieces *= TUNNELBRIDGE_TRACKBIT_FACTOR;
 		UpdateCompanyRoadInfrastructure(rt, GetRoadOwner(tile, rtt), num_pieces);
@@ -1196,6 +1206,7 @@ CommandCost CmdBuildRoadDepot(DoCommandFlag flags, TileIndex tile, RoadType rt,
 			/* A road depot has two road bits. */
 			UpdateCompanyRoadInfrastructure(rt, _current_company, ROAD_DEPOT_TRACKBIT_FACTOR);
 		}
+		YapfNotifyRoadLayoutChange(tile);
 
 		MarkTileDirtyByTile(tile);
 	}
@@ -2012,6 +2023,7 @@ static void TileLoop_Road(TileIndex tile)
 					IsNormalRoad(tile) && !HasAtMostOneBit(GetAllRoadBits(tile))) {
 				if (std::get<0>(GetFoundationSlope(tile)) == SLOPE_FLAT && EnsureNoVehicleOnGround(tile).Succeeded() && Chance16(1, 40)) {
 					StartRoadWorks(tile);
+					YapfNotifyRoadLayoutChange(tile);
 
 					if (_settings_client.sound.ambient) SndPlayTileFx(SND_21_ROAD_WORKS, tile);
 					CreateEffectVehicleAbove(
@@ -2048,6 +2060,7 @@ static void TileLoop_Road(TileIndex tile)
 		}
 	} else if (IncreaseRoadWorksCounter(tile)) {
 		TerminateRoadWorks(tile);
+		YapfNotifyRoadLayoutChange(tile);
 
 		if (_settings_game.economy.mod_road_rebuild) {
 			/* Generate a nicer town surface */
@@ -2070,6 +2083,7 @@ static void TileLoop_Road(TileIndex tile)
 			RoadType rt = GetTownRoadType();
 			if (rt != GetRoadTypeRoad(tile)) {
 				SetRoadType(tile, RTT_ROAD, rt);
+				YapfNotifyRoadLayoutChange(tile);
 			}
 		}
 
@@ -2536,6 +2550,7 @@ CommandCost CmdConvertRoad(DoCommandFlag flags, TileIndex tile, TileIndex area_s
 
 				/* Perform the conversion */
 				SetRoadType(tile, rtt, to_type);
+				YapfNotifyRoadLayoutChange(tile);
 				MarkTileDirtyByTile(tile);
 
 				/* update power of train on this tile */
@@ -2588,6 +2603,8 @@ CommandCost CmdConvertRoad(DoCommandFlag flags, TileIndex tile, TileIndex area_s
 				/* Perform the conversion */
 				SetRoadType(tile,    rtt, to_type);
 				SetRoadType(endtile, rtt, to_type);
+				YapfNotifyRoadLayoutChange(tile);
+				YapfNotifyRoadLayoutChange(endtile);
 
 				FindVehicleOnPos(tile, &affected_rvs, &UpdateRoadVehPowerProc);
 				FindVehicleOnPos(endtile, &affected_rvs, &UpdateRoadVehPowerProc);
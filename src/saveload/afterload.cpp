@@ -54,6 +54,8 @@
 #include "../smallmap_gui.h"
 #include "../news_func.h"
 #include "../order_backup.h"
+#include "../pbs.h"
+#include "../signal_func.h"
 #include "../error.h"
 #include "../disaster_vehicle.h"
 #include "../ship.h"
@@ -3294,6 +3296,10 @@ bool AfterLoadGame()
 	_gamelog.PrintDebug(1);
 
 	InitializeWindowsAndCaches();
+	/* Tracks and reservations might have been converted without telling the reservation cache. */
+	InvalidateReservationCache(INVALID_TILE);
+	InvalidateSignalSegments();
+	InvalidateTrainFreeRuns();
 	/* Restore the signals */
 	ResetSignalHandlers();
 
@@ -3341,6 +3347,12 @@ void ReloadNewGRFData()
 	GroupStatistics::UpdateAfterLoad();
 	/* update station graphics */
 	AfterLoadStations();
+	/* Station tiles might have become blocked, changing the platforms trains follow reservations over and signal blocks. */
+	InvalidateReservationCache(INVALID_TILE);
+	InvalidateSignalSegments();
+	InvalidateTrainFreeRuns();
+	/* Road and tram types and road stops might have changed, so shared road vehicle paths might be wrong. */
+	YapfNotifyRoadLayoutChange(INVALID_TILE);
 	/* Update company statistics. */
 	AfterLoadCompanyStats();
 	/* Check and update house and town values */
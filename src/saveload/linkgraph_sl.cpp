@@ -112,7 +112,7 @@ public:
 		SlSetStructListLength(lg->Size());
 		for (NodeID from = 0; from < lg->Size(); ++from) {
 			_linkgraph_from = from;
-			SlObject(&lg->nodes[from], this->GetDescription());
+			SlObject(lg->nodes[from].get(), this->GetDescription());
 		}
 	}
 
@@ -124,7 +124,7 @@ public:
 		lg->Init(length);
 		for (NodeID from = 0; from < length; ++from) {
 			_linkgraph_from = from;
-			SlObject(&lg->nodes[from], this->GetLoadDescription());
+			SlObject(lg->nodes[from].get(), this->GetLoadDescription());
 		}
 	}
 };
@@ -221,6 +221,7 @@ SaveLoadTable GetLinkGraphScheduleDesc()
 	static const SaveLoad schedule_desc[] = {
 		SLE_REFLIST(LinkGraphSchedule, schedule, REF_LINK_GRAPH),
 		SLE_REFLIST(LinkGraphSchedule, running,  REF_LINK_GRAPH_JOB),
+		SLE_CONDVAR(LinkGraphSchedule, join_postponed, SLE_BOOL, SLV_LINKGRAPH_JOIN_POSTPONED, SL_MAX_VERSION),
 	};
 	return schedule_desc;
 }
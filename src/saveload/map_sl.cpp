@@ -65,19 +65,59 @@ struct MAPSChunkHandler : ChunkHandler {
 };
 
 static const uint MAP_SL_BUF_SIZE = 4096;
+static const uint MAP_SL_LOAD_BUF_SIZE = 256 * 1024; ///< Number of tiles to load at once; large enough for the bytes to be read straight into the buffer.
+
+/**
+ * Load one of the map arrays, reading many tiles at once.
+ * @tparam T The type of the values in the array.
+ * @param set Function setting the value of a tile.
+ * @param conv The type the values are saved as.
+ */
+template <typename T, typename F>
+static void LoadMapArray(F set, VarType conv)
+{
+	uint size = Map::Size();
+	std::vector<T> buf(std::min(size, MAP_SL_LOAD_BUF_SIZE));
+
+	for (TileIndex i = 0; i != size;) {
+		SlCopy(buf.data(), buf.size(), conv);
+		for (const T &value : buf) set(value, Tile(i++));
+	}
+}
+
+/**
+ * Copy one of the map arrays, so it can be saved later while the game continues.
+ * @tparam T The type of the values in the array.
+ * @param get Function returning the value for a tile.
+ * @param conv The type to save the values as.
+ * @return Function saving the copied array.
+ */
+template <typename T, typename F>
+static std::function<void()> SnapshotMapArray(F get, VarType conv)
+{
+	uint size = Map::Size();
+	auto values = std::make_shared<std::vector<T>>(size);
+	for (TileIndex i = 0; i != size; i++) (*values)[i.base()] = get(Tile(i));
+
+	return [values, conv]() {
+		SlSetLength(static_cast<uint32_t>(values->size()) * sizeof(T));
+		SlCopy(values->data(), values->size(), conv);
+	};
+}
 
 struct MAPTChunkHandler : ChunkHandler {
 	MAPTChunkHandler() : ChunkHandler('MAPT', CH_RIFF) {}
 
-	void Load() const override
+	bool CanSaveConcurrently() const override { return true; }
+
+	std::function<void()> Snapshot() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
+		return SnapshotMapArray<uint8_t>([](Tile t) { return t.type(); }, SLE_UINT8);
+	}
 
-		for (TileIndex i = 0; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) Tile(i++).type() = buf[j];
-		}
+	void Load() const override
+	{
+		LoadMapArray<uint8_t>([](uint8_t value, Tile t) { t.type() = value; }, SLE_UINT8);
 	}
 
 	void Save() const override
@@ -96,15 +136,16 @@ struct MAPTChunkHandler : ChunkHandler {
 struct MAPHChunkHandler : ChunkHandler {
 	MAPHChunkHandler() : ChunkHandler('MAPH', CH_RIFF) {}
 
-	void Load() const override
+	bool CanSaveConcurrently() const override { return true; }
+
+	std::function<void()> Snapshot() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
+		return SnapshotMapArray<uint8_t>([](Tile t) { return t.height(); }, SLE_UINT8);
+	}
 
-		for (TileIndex i = 0; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) Tile(i++).height() = buf[j];
-		}
+	void Load() const override
+	{
+		LoadMapArray<uint8_t>([](uint8_t value, Tile t) { t.height() = value; }, SLE_UINT8);
 	}
 
 	void Save() const override
@@ -123,15 +164,16 @@ struct MAPHChunkHandler : ChunkHandler {
 struct MAPOChunkHandler : ChunkHandler {
 	MAPOChunkHandler() : ChunkHandler('MAPO', CH_RIFF) {}
 
-	void Load() const override
+	bool CanSaveConcurrently() const override { return true; }
+
+	std::function<void()> Snapshot() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
+		return SnapshotMapArray<uint8_t>([](Tile t) { return t.m1(); }, SLE_UINT8);
+	}
 
-		for (TileIndex i = 0; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) Tile(i++).m1() = buf[j];
-		}
+	void Load() const override
+	{
+		LoadMapArray<uint8_t>([](uint8_t value, Tile t) { t.m1() = value; }, SLE_UINT8);
 	}
 
 	void Save() const override
@@ -150,18 +192,19 @@ struct MAPOChunkHandler : ChunkHandler {
 struct MAP2ChunkHandler : ChunkHandler {
 	MAP2ChunkHandler() : ChunkHandler('MAP2', CH_RIFF) {}
 
-	void Load() const override
+	bool CanSaveConcurrently() const override { return true; }
+
+	std::function<void()> Snapshot() const override
 	{
-		std::array<uint16_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
+		return SnapshotMapArray<uint16_t>([](Tile t) { return t.m2(); }, SLE_UINT16);
+	}
 
-		for (TileIndex i = 0; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE,
-				/* In those versions the m2 was 8 bits */
-				IsSavegameVersionBefore(SLV_5) ? SLE_FILE_U8 | SLE_VAR_U16 : SLE_UINT16
-			);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) Tile(i++).m2() = buf[j];
-		}
+	void Load() const override
+	{
+		LoadMapArray<uint16_t>([](uint16_t value, Tile t) { t.m2() = value; },
+			/* In those versions the m2 was 8 bits */
+			IsSavegameVersionBefore(SLV_5) ? SLE_FILE_U8 | SLE_VAR_U16 : SLE_UINT16
+		);
 	}
 
 	void Save() const override
@@ -180,15 +223,16 @@ struct MAP2ChunkHandler : ChunkHandler {
 struct M3LOChunkHandler : ChunkHandler {
 	M3LOChunkHandler() : ChunkHandler('M3LO', CH_RIFF) {}
 
-	void Load() const override
+	bool CanSaveConcurrently() const override { return true; }
+
+	std::function<void()> Snapshot() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
+		return SnapshotMapArray<uint8_t>([](Tile t) { return t.m3(); }, SLE_UINT8);
+	}
 
-		for (TileIndex i = 0; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) Tile(i++).m3() = buf[j];
-		}
+	void Load() const override
+	{
+		LoadMapArray<uint8_t>([](uint8_t value, Tile t) { t.m3() = value; }, SLE_UINT8);
 	}
 
 	void Save() const override
@@ -207,15 +251,16 @@ struct M3LOChunkHandler : ChunkHandler {
 struct M3HIChunkHandler : ChunkHandler {
 	M3HIChunkHandler() : ChunkHandler('M3HI', CH_RIFF) {}
 
-	void Load() const override
+	bool CanSaveConcurrently() const override { return true; }
+
+	std::function<void()> Snapshot() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
+		return SnapshotMapArray<uint8_t>([](Tile t) { return t.m4(); }, SLE_UINT8);
+	}
 
-		for (TileIndex i = 0; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) Tile(i++).m4() = buf[j];
-		}
+	void Load() const override
+	{
+		LoadMapArray<uint8_t>([](uint8_t value, Tile t) { t.m4() = value; }, SLE_UINT8);
 	}
 
 	void Save() const override
@@ -234,15 +279,16 @@ struct M3HIChunkHandler : ChunkHandler {
 struct MAP5ChunkHandler : ChunkHandler {
 	MAP5ChunkHandler() : ChunkHandler('MAP5', CH_RIFF) {}
 
-	void Load() const override
+	bool CanSaveConcurrently() const override { return true; }
+
+	std::function<void()> Snapshot() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
+		return SnapshotMapArray<uint8_t>([](Tile t) { return t.m5(); }, SLE_UINT8);
+	}
 
-		for (TileIndex i = 0; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) Tile(i++).m5() = buf[j];
-		}
+	void Load() const override
+	{
+		LoadMapArray<uint8_t>([](uint8_t value, Tile t) { t.m5() = value; }, SLE_UINT8);
 	}
 
 	void Save() const override
@@ -261,6 +307,13 @@ struct MAP5ChunkHandler : ChunkHandler {
 struct MAPEChunkHandler : ChunkHandler {
 	MAPEChunkHandler() : ChunkHandler('MAPE', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
+	std::function<void()> Snapshot() const override
+	{
+		return SnapshotMapArray<uint8_t>([](Tile t) { return t.m6(); }, SLE_UINT8);
+	}
+
 	void Load() const override
 	{
 		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
@@ -278,10 +331,7 @@ struct MAPEChunkHandler : ChunkHandler {
 				}
 			}
 		} else {
-			for (TileIndex i = 0; i != size;) {
-				SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-				for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) Tile(i++).m6() = buf[j];
-			}
+			LoadMapArray<uint8_t>([](uint8_t value, Tile t) { t.m6() = value; }, SLE_UINT8);
 		}
 	}
 
@@ -301,15 +351,16 @@ struct MAPEChunkHandler : ChunkHandler {
 struct MAP7ChunkHandler : ChunkHandler {
 	MAP7ChunkHandler() : ChunkHandler('MAP7', CH_RIFF) {}
 
-	void Load() const override
+	bool CanSaveConcurrently() const override { return true; }
+
+	std::function<void()> Snapshot() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
+		return SnapshotMapArray<uint8_t>([](Tile t) { return t.m7(); }, SLE_UINT8);
+	}
 
-		for (TileIndex i = 0; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) Tile(i++).m7() = buf[j];
-		}
+	void Load() const override
+	{
+		LoadMapArray<uint8_t>([](uint8_t value, Tile t) { t.m7() = value; }, SLE_UINT8);
 	}
 
 	void Save() const override
@@ -328,15 +379,16 @@ struct MAP7ChunkHandler : ChunkHandler {
 struct MAP8ChunkHandler : ChunkHandler {
 	MAP8ChunkHandler() : ChunkHandler('MAP8', CH_RIFF) {}
 
-	void Load() const override
+	bool CanSaveConcurrently() const override { return true; }
+
+	std::function<void()> Snapshot() const override
 	{
-		std::array<uint16_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
+		return SnapshotMapArray<uint16_t>([](Tile t) { return t.m8(); }, SLE_UINT16);
+	}
 
-		for (TileIndex i = 0; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT16);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) Tile(i++).m8() = buf[j];
-		}
+	void Load() const override
+	{
+		LoadMapArray<uint16_t>([](uint16_t value, Tile t) { t.m8() = value; }, SLE_UINT16);
 	}
 
 	void Save() const override
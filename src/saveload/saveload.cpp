@@ -15,7 +15,7 @@
  * <li>use their description array (#SaveLoad) to know what elements to save and in what version
  *    of the game it was active (used when loading)
  * <li>write all data byte-by-byte to the temporary buffer so it is endian-safe
- * <li>when the buffer is full; flush it to the output (eg save to file) (_sl.buf, _sl.bufp, _sl.bufe)
+ * <li>when the buffer is full; flush it to the output (eg save to file) (_sl->buf, _sl->bufp, _sl->bufe)
  * <li>repeat this until everything is done, and flush any remaining output to file
  * </ol>
  */
@@ -42,6 +42,8 @@
 #include "../string_func.h"
 #include "../fios.h"
 #include "../error.h"
+#include "../settings_type.h"
+#include "../thread_pool.h"
 #include <atomic>
 #ifdef __EMSCRIPTEN__
 #	include <emscripten.h>
@@ -63,6 +65,8 @@ uint32_t _ttdp_version;         ///< version of TTDP savegame (if applicable)
 SaveLoadVersion _sl_version;  ///< the major savegame version identifier
 uint8_t   _sl_minor_version;     ///< the minor savegame version, DO NOT USE!
 std::string _savegame_format; ///< how to compress savegames
+uint8_t _savegame_compression_workers; ///< number of worker threads compressing savegames, for the formats that support it
+bool _savegame_blocks;                 ///< whether to write savegames as blocks that are compressed in parallel
 bool _do_autosave;            ///< are we doing an autosave at the moment?
 
 /** What are we currently doing? */
@@ -99,20 +103,54 @@ struct ReadBuffer {
 	{
 	}
 
-	inline uint8_t ReadByte()
+	/** Fill the buffer with the next bytes from the filter. */
+	void FillBuffer()
 	{
-		if (this->bufp == this->bufe) {
-			size_t len = this->reader->Read(this->buf, lengthof(this->buf));
-			if (len == 0) SlErrorCorrupt("Unexpected end of chunk");
+		size_t len = this->reader->Read(this->buf, lengthof(this->buf));
+		if (len == 0) SlErrorCorrupt("Unexpected end of chunk");
 
-			this->read += len;
-			this->bufp = this->buf;
-			this->bufe = this->buf + len;
-		}
+		this->read += len;
+		this->bufp = this->buf;
+		this->bufe = this->buf + len;
+	}
+
+	inline uint8_t ReadByte()
+	{
+		if (this->bufp == this->bufe) this->FillBuffer();
 
 		return *this->bufp++;
 	}
 
+	/**
+	 * Read a number of bytes at once.
+	 * Once the buffer is empty, reads of at least a buffer's size go straight from the filter into the destination.
+	 * @param ptr The destination of the bytes.
+	 * @param length The number of bytes to read.
+	 */
+	void CopyBytes(uint8_t *ptr, size_t length)
+	{
+		while (length != 0) {
+			if (this->bufp == this->bufe) {
+				if (length >= lengthof(this->buf)) {
+					size_t len = this->reader->Read(ptr, length);
+					if (len == 0) SlErrorCorrupt("Unexpected end of chunk");
+
+					this->read += len;
+					ptr += len;
+					length -= len;
+					continue;
+				}
+				this->FillBuffer();
+			}
+
+			size_t len = std::min<size_t>(length, this->bufe - this->bufp);
+			std::copy_n(this->bufp, len, ptr);
+			this->bufp += len;
+			ptr += len;
+			length -= len;
+		}
+	}
+
 	/**
 	 * Get the size of the memory dump made so far.
 	 * @return The size.
@@ -146,22 +184,55 @@ struct MemoryDumper {
 	}
 
 	/**
-	 * Flush this dumper into a writer.
-	 * @param writer The filter we want to use.
+	 * Write a number of bytes into the dumper.
+	 * @param buf The bytes to write.
+	 * @param size The number of bytes to write.
 	 */
-	void Flush(std::shared_ptr<SaveFilter> writer)
+	void Write(const uint8_t *buf, size_t size)
 	{
-		uint i = 0;
-		size_t t = this->GetSize();
+		while (size > 0) {
+			if (this->buf == this->bufe) {
+				this->buf = this->blocks.emplace_back(std::make_unique<uint8_t[]>(MEMORY_CHUNK_SIZE)).get();
+				this->bufe = this->buf + MEMORY_CHUNK_SIZE;
+			}
 
-		while (t > 0) {
-			size_t to_write = std::min(MEMORY_CHUNK_SIZE, t);
+			size_t to_write = std::min<size_t>(this->bufe - this->buf, size);
+			std::copy_n(buf, to_write, this->buf);
+			this->buf += to_write;
+			buf += to_write;
+			size -= to_write;
+		}
+	}
 
-			writer->Write(this->blocks[i++].get(), to_write);
+	/**
+	 * Append everything dumped into another dumper to this dumper.
+	 * @param other The dumper to copy from.
+	 */
+	void Append(const MemoryDumper &other)
+	{
+		size_t t = other.GetSize();
+		for (const auto &block : other.blocks) {
+			size_t to_write = std::min(MEMORY_CHUNK_SIZE, t);
+			this->Write(block.get(), to_write);
 			t -= to_write;
 		}
+	}
+
+	/**
+	 * Write a part of this dumper into a writer.
+	 * @param writer The filter we want to use.
+	 * @param pos The position of the first byte to write.
+	 * @param end The position just after the last byte to write.
+	 */
+	void WriteTo(SaveFilter &writer, size_t pos, size_t end) const
+	{
+		while (pos < end) {
+			size_t offset = pos % MEMORY_CHUNK_SIZE;
+			size_t to_write = std::min(MEMORY_CHUNK_SIZE - offset, end - pos);
 
-		writer->Finish();
+			writer.Write(this->blocks[pos / MEMORY_CHUNK_SIZE].get() + offset, to_write);
+			pos += to_write;
+		}
 	}
 
 	/**
@@ -188,6 +259,17 @@ struct SaveLoadParams {
 	std::unique_ptr<MemoryDumper> dumper; ///< Memory dumper to write the savegame to.
 	std::shared_ptr<SaveFilter> sf; ///< Filter to write the savegame to.
 
+	std::string format; ///< Format to write the savegame in, like #_savegame_format.
+	bool blocks; ///< Whether to write the savegame as independently compressed blocks, like #_savegame_blocks.
+
+	/** A chunk in the savegame; it is either in #dumper, or saved from its snapshot when the savegame is written. */
+	struct SavedChunk {
+		size_t offset;                   ///< Position in #dumper where the chunk starts or belongs.
+		const ChunkHandler *ch;          ///< The chunk handler.
+		std::function<void()> snapshot;  ///< Function saving the chunk from its snapshot, or nullptr when it is in #dumper.
+	};
+	std::vector<SavedChunk> chunks; ///< The chunks in savegame order.
+
 	std::unique_ptr<ReadBuffer> reader; ///< Savegame reading buffer.
 	std::shared_ptr<LoadFilter> lf; ///< Filter to read the savegame from.
 
@@ -195,9 +277,11 @@ struct SaveLoadParams {
 	std::string extra_msg;               ///< the error message
 
 	bool saveinprogress;                 ///< Whether there is currently a save in progress.
+	bool separate;                       ///< Whether these parameters are for work done by #SlRunSeparately; errors then do not touch any global state.
 };
 
-static SaveLoadParams _sl; ///< Parameters used for/at saveload.
+static SaveLoadParams _sl_game; ///< Parameters used for/at saveload by the game and savegame threads.
+static thread_local SaveLoadParams *_sl = &_sl_game; ///< Parameters used for/at saveload; chunks saved on worker threads get their own.
 
 static const std::vector<ChunkHandlerRef> &ChunkHandlers()
 {
@@ -295,7 +379,7 @@ static const std::vector<ChunkHandlerRef> &ChunkHandlers()
 /** Null all pointers (convert index -> nullptr) */
 static void SlNullPointers()
 {
-	_sl.action = SLA_NULL;
+	_sl->action = SLA_NULL;
 
 	/* We don't want any savegame conversion code to run
 	 * during NULLing; especially those that try to get
@@ -307,7 +391,7 @@ static void SlNullPointers()
 		ch.FixPointers();
 	}
 
-	assert(_sl.action == SLA_NULL);
+	assert(_sl->action == SLA_NULL);
 }
 
 /**
@@ -320,20 +404,27 @@ static void SlNullPointers()
  */
 [[noreturn]] void SlError(StringID string, const std::string &extra_msg)
 {
+	/* Work done separately, possibly on another thread, only records the error; the owning thread raises it again. */
+	if (_sl->separate) {
+		_sl->error_str = string;
+		_sl->extra_msg = extra_msg;
+		throw std::exception();
+	}
+
 	/* Distinguish between loading into _load_check_data vs. normal save/load. */
-	if (_sl.action == SLA_LOAD_CHECK) {
+	if (_sl->action == SLA_LOAD_CHECK) {
 		_load_check_data.error = string;
 		_load_check_data.error_msg = extra_msg;
 	} else {
-		_sl.error_str = string;
-		_sl.extra_msg = extra_msg;
+		_sl->error_str = string;
+		_sl->extra_msg = extra_msg;
 	}
 
 	/* We have to nullptr all pointers here; we might be in a state where
 	 * the pointers are actually filled with indices, which means that
 	 * when we access them during cleaning the pool dereferences of
 	 * those indices will be made with segmentation faults as result. */
-	if (_sl.action == SLA_LOAD || _sl.action == SLA_PTRS) SlNullPointers();
+	if (_sl->action == SLA_LOAD || _sl->action == SLA_PTRS) SlNullPointers();
 
 	/* Logging could be active. */
 	_gamelog.StopAnyAction();
@@ -391,7 +482,7 @@ void ProcessAsyncSaveFinish()
  */
 uint8_t SlReadByte()
 {
-	return _sl.reader->ReadByte();
+	return _sl->reader->ReadByte();
 }
 
 /**
@@ -400,7 +491,7 @@ uint8_t SlReadByte()
  */
 void SlWriteByte(uint8_t b)
 {
-	_sl.dumper->WriteByte(b);
+	_sl->dumper->WriteByte(b);
 }
 
 static inline int SlReadUint16()
@@ -645,8 +736,8 @@ static inline size_t SlCalcRefLen()
 
 void SlSetArrayIndex(uint index)
 {
-	_sl.need_length = NL_WANTLENGTH;
-	_sl.array_index = index;
+	_sl->need_length = NL_WANTLENGTH;
+	_sl->array_index = index;
 }
 
 static size_t _next_offs;
@@ -659,32 +750,32 @@ int SlIterateArray()
 {
 	/* After reading in the whole array inside the loop
 	 * we must have read in all the data, so we must be at end of current block. */
-	if (_next_offs != 0 && _sl.reader->GetSize() != _next_offs) {
-		SlErrorCorruptFmt("Invalid chunk size iterating array - expected to be at position {}, actually at {}", _next_offs, _sl.reader->GetSize());
+	if (_next_offs != 0 && _sl->reader->GetSize() != _next_offs) {
+		SlErrorCorruptFmt("Invalid chunk size iterating array - expected to be at position {}, actually at {}", _next_offs, _sl->reader->GetSize());
 	}
 
 	for (;;) {
 		uint length = SlReadArrayLength();
 		if (length == 0) {
-			assert(!_sl.expect_table_header);
+			assert(!_sl->expect_table_header);
 			_next_offs = 0;
 			return -1;
 		}
 
-		_sl.obj_len = --length;
-		_next_offs = _sl.reader->GetSize() + length;
+		_sl->obj_len = --length;
+		_next_offs = _sl->reader->GetSize() + length;
 
-		if (_sl.expect_table_header) {
-			_sl.expect_table_header = false;
+		if (_sl->expect_table_header) {
+			_sl->expect_table_header = false;
 			return INT32_MAX;
 		}
 
 		int index;
-		switch (_sl.block_mode) {
+		switch (_sl->block_mode) {
 			case CH_SPARSE_TABLE:
 			case CH_SPARSE_ARRAY: index = (int)SlReadSparseIndex(); break;
 			case CH_TABLE:
-			case CH_ARRAY:        index = _sl.array_index++; break;
+			case CH_ARRAY:        index = _sl->array_index++; break;
 			default:
 				Debug(sl, 0, "SlIterateArray error");
 				return -1; // error
@@ -700,7 +791,7 @@ int SlIterateArray()
 void SlSkipArray()
 {
 	while (SlIterateArray() != -1) {
-		SlSkipBytes(_next_offs - _sl.reader->GetSize());
+		SlSkipBytes(_next_offs - _sl->reader->GetSize());
 	}
 }
 
@@ -711,18 +802,18 @@ void SlSkipArray()
  */
 void SlSetLength(size_t length)
 {
-	assert(_sl.action == SLA_SAVE);
+	assert(_sl->action == SLA_SAVE);
 
-	switch (_sl.need_length) {
+	switch (_sl->need_length) {
 		case NL_WANTLENGTH:
-			_sl.need_length = NL_NONE;
-			if ((_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE) && _sl.expect_table_header) {
-				_sl.expect_table_header = false;
+			_sl->need_length = NL_NONE;
+			if ((_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE) && _sl->expect_table_header) {
+				_sl->expect_table_header = false;
 				SlWriteArrayLength(length + 1);
 				break;
 			}
 
-			switch (_sl.block_mode) {
+			switch (_sl->block_mode) {
 				case CH_RIFF:
 					/* Ugly encoding of >16M RIFF chunks
 					 * The lower 24 bits are normal
@@ -732,23 +823,23 @@ void SlSetLength(size_t length)
 					break;
 				case CH_TABLE:
 				case CH_ARRAY:
-					assert(_sl.last_array_index <= _sl.array_index);
-					while (++_sl.last_array_index <= _sl.array_index) {
+					assert(_sl->last_array_index <= _sl->array_index);
+					while (++_sl->last_array_index <= _sl->array_index) {
 						SlWriteArrayLength(1);
 					}
 					SlWriteArrayLength(length + 1);
 					break;
 				case CH_SPARSE_TABLE:
 				case CH_SPARSE_ARRAY:
-					SlWriteArrayLength(length + 1 + SlGetArrayLength(_sl.array_index)); // Also include length of sparse index.
-					SlWriteSparseIndex(_sl.array_index);
+					SlWriteArrayLength(length + 1 + SlGetArrayLength(_sl->array_index)); // Also include length of sparse index.
+					SlWriteSparseIndex(_sl->array_index);
 					break;
 				default: NOT_REACHED();
 			}
 			break;
 
 		case NL_CALCLENGTH:
-			_sl.obj_len += (int)length;
+			_sl->obj_len += (int)length;
 			break;
 
 		default: NOT_REACHED();
@@ -765,10 +856,10 @@ static void SlCopyBytes(void *ptr, size_t length)
 {
 	uint8_t *p = (uint8_t *)ptr;
 
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_LOAD_CHECK:
 		case SLA_LOAD:
-			for (; length != 0; length--) *p++ = SlReadByte();
+			_sl->reader->CopyBytes(p, length);
 			break;
 		case SLA_SAVE:
 			for (; length != 0; length--) SlWriteByte(*p++);
@@ -780,7 +871,7 @@ static void SlCopyBytes(void *ptr, size_t length)
 /** Get the length of the current object */
 size_t SlGetFieldLength()
 {
-	return _sl.obj_len;
+	return _sl->obj_len;
 }
 
 /**
@@ -842,7 +933,7 @@ void WriteValue(void *ptr, VarType conv, int64_t val)
  */
 static void SlSaveLoadConv(void *ptr, VarType conv)
 {
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_SAVE: {
 			int64_t x = ReadValue(ptr, conv);
 
@@ -933,7 +1024,7 @@ static void SlStdString(void *ptr, VarType conv)
 {
 	std::string *str = reinterpret_cast<std::string *>(ptr);
 
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_SAVE: {
 			size_t len = str->length();
 			SlWriteArrayLength(len);
@@ -980,14 +1071,14 @@ static void SlStdString(void *ptr, VarType conv)
 static void SlCopyInternal(void *object, size_t length, VarType conv)
 {
 	if (GetVarMemType(conv) == SLE_VAR_NULL) {
-		assert(_sl.action != SLA_SAVE); // Use SL_NULL if you want to write null-bytes
+		assert(_sl->action != SLA_SAVE); // Use SL_NULL if you want to write null-bytes
 		SlSkipBytes(length * SlCalcConvFileLen(conv));
 		return;
 	}
 
 	/* NOTICE - handle some buggy stuff, in really old versions everything was saved
 	 * as a byte-type. So detect this, and adjust object size accordingly */
-	if (_sl.action != SLA_SAVE && _sl_version == 0) {
+	if (_sl->action != SLA_SAVE && _sl_version == 0) {
 		/* all objects except difficulty settings */
 		if (conv == SLE_INT16 || conv == SLE_UINT16 || conv == SLE_STRINGID ||
 				conv == SLE_INT32 || conv == SLE_UINT32) {
@@ -1007,6 +1098,15 @@ static void SlCopyInternal(void *object, size_t length, VarType conv)
 	 * conversion is needed, use specialized copy-copy function to speed up things */
 	if (conv == SLE_INT8 || conv == SLE_UINT8) {
 		SlCopyBytes(object, length);
+	} else if (_sl->action != SLA_SAVE && (conv == SLE_INT16 || conv == SLE_UINT16)) {
+		/* Same size in file and memory as well, so read them all at once and only fix the byte order. */
+		uint16_t *a = static_cast<uint16_t *>(object);
+		SlCopyBytes(a, length * sizeof(uint16_t));
+		for (size_t i = 0; i != length; i++) a[i] = FROM_BE16(a[i]);
+	} else if (_sl->action != SLA_SAVE && (conv == SLE_INT32 || conv == SLE_UINT32)) {
+		uint32_t *a = static_cast<uint32_t *>(object);
+		SlCopyBytes(a, length * sizeof(uint32_t));
+		for (size_t i = 0; i != length; i++) a[i] = FROM_BE32(a[i]);
 	} else {
 		uint8_t *a = (uint8_t*)object;
 		uint8_t mem_size = SlCalcConvMemLen(conv);
@@ -1028,13 +1128,13 @@ static void SlCopyInternal(void *object, size_t length, VarType conv)
  */
 void SlCopy(void *object, size_t length, VarType conv)
 {
-	if (_sl.action == SLA_PTRS || _sl.action == SLA_NULL) return;
+	if (_sl->action == SLA_PTRS || _sl->action == SLA_NULL) return;
 
 	/* Automatically calculate the length? */
-	if (_sl.need_length != NL_NONE) {
+	if (_sl->need_length != NL_NONE) {
 		SlSetLength(length * SlCalcConvFileLen(conv));
 		/* Determine length only? */
-		if (_sl.need_length == NL_CALCLENGTH) return;
+		if (_sl->need_length == NL_CALCLENGTH) return;
 	}
 
 	SlCopyInternal(object, length, conv);
@@ -1058,7 +1158,7 @@ static inline size_t SlCalcArrayLen(size_t length, VarType conv)
  */
 static void SlArray(void *array, size_t length, VarType conv)
 {
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_SAVE:
 			SlWriteArrayLength(length);
 			SlCopyInternal(array, length, conv);
@@ -1104,7 +1204,7 @@ static void SlArray(void *array, size_t length, VarType conv)
  */
 static size_t ReferenceToInt(const void *obj, SLRefType rt)
 {
-	assert(_sl.action == SLA_SAVE);
+	assert(_sl->action == SLA_SAVE);
 
 	if (obj == nullptr) return 0;
 
@@ -1139,7 +1239,7 @@ static void *IntToReference(size_t index, SLRefType rt)
 {
 	static_assert(sizeof(size_t) <= sizeof(void *));
 
-	assert(_sl.action == SLA_PTRS);
+	assert(_sl->action == SLA_PTRS);
 
 	/* After version 4.3 REF_VEHICLE_OLD is saved as REF_VEHICLE,
 	 * and should be loaded like that */
@@ -1213,7 +1313,7 @@ static void *IntToReference(size_t index, SLRefType rt)
  */
 void SlSaveLoadRef(void *ptr, VarType conv)
 {
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_SAVE:
 			SlWriteUint32((uint32_t)ReferenceToInt(*(void **)ptr, (SLRefType)conv));
 			break;
@@ -1282,7 +1382,7 @@ public:
 
 		SlStorageT *list = static_cast<SlStorageT *>(storage);
 
-		switch (_sl.action) {
+		switch (_sl->action) {
 			case SLA_SAVE:
 				SlWriteArrayLength(list->size());
 
@@ -1342,10 +1442,10 @@ static inline size_t SlCalcRefListLen(const void *list, VarType conv)
 static void SlRefList(void *list, VarType conv)
 {
 	/* Automatically calculate the length? */
-	if (_sl.need_length != NL_NONE) {
+	if (_sl->need_length != NL_NONE) {
 		SlSetLength(SlCalcRefListLen(list, conv));
 		/* Determine length only? */
-		if (_sl.need_length == NL_CALCLENGTH) return;
+		if (_sl->need_length == NL_CALCLENGTH) return;
 	}
 
 	SlStorageHelper<std::list, void *>::SlSaveLoad(list, conv, SL_REF);
@@ -1492,7 +1592,7 @@ size_t SlCalcObjLength(const void *object, const SaveLoadTable &slt)
 
 size_t SlCalcObjMemberLength(const void *object, const SaveLoad &sld)
 {
-	assert(_sl.action == SLA_SAVE);
+	assert(_sl->action == SLA_SAVE);
 
 	if (!SlIsObjectValidInSavegame(sld)) return 0;
 
@@ -1509,20 +1609,20 @@ size_t SlCalcObjMemberLength(const void *object, const SaveLoad &sld)
 
 		case SL_STRUCT:
 		case SL_STRUCTLIST: {
-			NeedLength old_need_length = _sl.need_length;
-			size_t old_obj_len = _sl.obj_len;
+			NeedLength old_need_length = _sl->need_length;
+			size_t old_obj_len = _sl->obj_len;
 
-			_sl.need_length = NL_CALCLENGTH;
-			_sl.obj_len = 0;
+			_sl->need_length = NL_CALCLENGTH;
+			_sl->obj_len = 0;
 
 			/* Pretend that we are saving to collect the object size. Other
 			 * means are difficult, as we don't know the length of the list we
 			 * are about to store. */
 			sld.handler->Save(const_cast<void *>(object));
-			size_t length = _sl.obj_len;
+			size_t length = _sl->obj_len;
 
-			_sl.obj_len = old_obj_len;
-			_sl.need_length = old_need_length;
+			_sl->obj_len = old_obj_len;
+			_sl->need_length = old_need_length;
 
 			if (sld.cmd == SL_STRUCT) {
 				length += SlGetArrayLength(1);
@@ -1570,7 +1670,7 @@ static bool SlObjectMember(void *object, const SaveLoad &sld)
 		case SL_SAVEBYTE: {
 			void *ptr = GetVariableAddress(object, sld);
 
-			switch (_sl.action) {
+			switch (_sl->action) {
 				case SLA_SAVE: SlWriteByte(*(uint8_t *)ptr); break;
 				case SLA_LOAD_CHECK:
 				case SLA_LOAD:
@@ -1584,7 +1684,7 @@ static bool SlObjectMember(void *object, const SaveLoad &sld)
 		case SL_NULL: {
 			assert(GetVarMemType(sld.conv) == SLE_VAR_NULL);
 
-			switch (_sl.action) {
+			switch (_sl->action) {
 				case SLA_LOAD_CHECK:
 				case SLA_LOAD: SlSkipBytes(SlCalcConvFileLen(sld.conv) * sld.length); break;
 				case SLA_SAVE: for (int i = 0; i < SlCalcConvFileLen(sld.conv) * sld.length; i++) SlWriteByte(0); break;
@@ -1597,7 +1697,7 @@ static bool SlObjectMember(void *object, const SaveLoad &sld)
 
 		case SL_STRUCT:
 		case SL_STRUCTLIST:
-			switch (_sl.action) {
+			switch (_sl->action) {
 				case SLA_SAVE: {
 					if (sld.cmd == SL_STRUCT) {
 						/* Store in the savegame if this struct was written or not. */
@@ -1644,9 +1744,9 @@ static bool SlObjectMember(void *object, const SaveLoad &sld)
 void SlSetStructListLength(size_t length)
 {
 	/* Automatically calculate the length? */
-	if (_sl.need_length != NL_NONE) {
+	if (_sl->need_length != NL_NONE) {
 		SlSetLength(SlGetArrayLength(length));
-		if (_sl.need_length == NL_CALCLENGTH) return;
+		if (_sl->need_length == NL_CALCLENGTH) return;
 	}
 
 	SlWriteArrayLength(length);
@@ -1673,9 +1773,9 @@ size_t SlGetStructListLength(size_t limit)
 void SlObject(void *object, const SaveLoadTable &slt)
 {
 	/* Automatically calculate the length? */
-	if (_sl.need_length != NL_NONE) {
+	if (_sl->need_length != NL_NONE) {
 		SlSetLength(SlCalcObjLength(object, slt));
-		if (_sl.need_length == NL_CALCLENGTH) return;
+		if (_sl->need_length == NL_CALCLENGTH) return;
 	}
 
 	for (auto &sld : slt) {
@@ -1726,9 +1826,9 @@ class SlSkipHandler : public SaveLoadHandler {
 std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
 {
 	/* You can only use SlTableHeader if you are a CH_TABLE. */
-	assert(_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE);
+	assert(_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE);
 
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_LOAD_CHECK:
 		case SLA_LOAD: {
 			std::vector<SaveLoad> saveloads;
@@ -1754,7 +1854,7 @@ std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
 				auto sld_it = key_lookup.find(key);
 				if (sld_it == key_lookup.end()) {
 					/* SLA_LOADCHECK triggers this debug statement a lot and is perfectly normal. */
-					Debug(sl, _sl.action == SLA_LOAD ? 2 : 6, "Field '{}' of type 0x{:02x} not found, skipping", key, type);
+					Debug(sl, _sl->action == SLA_LOAD ? 2 : 6, "Field '{}' of type 0x{:02x} not found, skipping", key, type);
 
 					std::shared_ptr<SaveLoadHandler> handler = nullptr;
 					SaveLoadType saveload_type;
@@ -1804,9 +1904,9 @@ std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
 
 		case SLA_SAVE: {
 			/* Automatically calculate the length? */
-			if (_sl.need_length != NL_NONE) {
+			if (_sl->need_length != NL_NONE) {
 				SlSetLength(SlCalcTableHeader(slt));
-				if (_sl.need_length == NL_CALCLENGTH) break;
+				if (_sl->need_length == NL_CALCLENGTH) break;
 			}
 
 			for (auto &sld : slt) {
@@ -1830,12 +1930,12 @@ std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
 				if (!SlIsObjectValidInSavegame(sld)) continue;
 				if (sld.cmd == SL_STRUCTLIST || sld.cmd == SL_STRUCT) {
 					/* SlCalcTableHeader already looks in sub-lists, so avoid the length being added twice. */
-					NeedLength old_need_length = _sl.need_length;
-					_sl.need_length = NL_NONE;
+					NeedLength old_need_length = _sl->need_length;
+					_sl->need_length = NL_NONE;
 
 					SlTableHeader(sld.handler->GetDescription());
 
-					_sl.need_length = old_need_length;
+					_sl->need_length = old_need_length;
 				}
 			}
 
@@ -1863,9 +1963,9 @@ std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
  */
 std::vector<SaveLoad> SlCompatTableHeader(const SaveLoadTable &slt, const SaveLoadCompatTable &slct)
 {
-	assert(_sl.action == SLA_LOAD || _sl.action == SLA_LOAD_CHECK);
+	assert(_sl->action == SLA_LOAD || _sl->action == SLA_LOAD_CHECK);
 	/* CH_TABLE / CH_SPARSE_TABLE always have a header. */
-	if (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE) return SlTableHeader(slt);
+	if (_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE) return SlTableHeader(slt);
 
 	std::vector<SaveLoad> saveloads;
 
@@ -1927,31 +2027,31 @@ void SlGlobList(const SaveLoadTable &slt)
  */
 void SlAutolength(AutolengthProc *proc, void *arg)
 {
-	assert(_sl.action == SLA_SAVE);
+	assert(_sl->action == SLA_SAVE);
 
 	/* Tell it to calculate the length */
-	_sl.need_length = NL_CALCLENGTH;
-	_sl.obj_len = 0;
+	_sl->need_length = NL_CALCLENGTH;
+	_sl->obj_len = 0;
 	proc(arg);
 
 	/* Setup length */
-	_sl.need_length = NL_WANTLENGTH;
-	SlSetLength(_sl.obj_len);
+	_sl->need_length = NL_WANTLENGTH;
+	SlSetLength(_sl->obj_len);
 
-	size_t start_pos = _sl.dumper->GetSize();
-	size_t expected_offs = start_pos + _sl.obj_len;
+	size_t start_pos = _sl->dumper->GetSize();
+	size_t expected_offs = start_pos + _sl->obj_len;
 
 	/* And write the stuff */
 	proc(arg);
 
-	if (expected_offs != _sl.dumper->GetSize()) {
-		SlErrorCorruptFmt("Invalid chunk size when writing autolength block, expected {}, got {}", _sl.obj_len, _sl.dumper->GetSize() - start_pos);
+	if (expected_offs != _sl->dumper->GetSize()) {
+		SlErrorCorruptFmt("Invalid chunk size when writing autolength block, expected {}, got {}", _sl->obj_len, _sl->dumper->GetSize() - start_pos);
 	}
 }
 
 void ChunkHandler::LoadCheck(size_t len) const
 {
-	switch (_sl.block_mode) {
+	switch (_sl->block_mode) {
 		case CH_TABLE:
 		case CH_SPARSE_TABLE:
 			SlTableHeader({});
@@ -1976,20 +2076,20 @@ static void SlLoadChunk(const ChunkHandler &ch)
 {
 	uint8_t m = SlReadByte();
 
-	_sl.block_mode = m & CH_TYPE_MASK;
-	_sl.obj_len = 0;
-	_sl.expect_table_header = (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE);
+	_sl->block_mode = m & CH_TYPE_MASK;
+	_sl->obj_len = 0;
+	_sl->expect_table_header = (_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE);
 
 	/* The header should always be at the start. Read the length; the
 	 * Load() should as first action process the header. */
-	if (_sl.expect_table_header) {
+	if (_sl->expect_table_header) {
 		SlIterateArray();
 	}
 
-	switch (_sl.block_mode) {
+	switch (_sl->block_mode) {
 		case CH_TABLE:
 		case CH_ARRAY:
-			_sl.array_index = 0;
+			_sl->array_index = 0;
 			ch.Load();
 			if (_next_offs != 0) SlErrorCorrupt("Invalid array length");
 			break;
@@ -2002,13 +2102,13 @@ static void SlLoadChunk(const ChunkHandler &ch)
 			/* Read length */
 			size_t len = (SlReadByte() << 16) | ((m >> 4) << 24);
 			len += SlReadUint16();
-			_sl.obj_len = len;
-			size_t start_pos = _sl.reader->GetSize();
+			_sl->obj_len = len;
+			size_t start_pos = _sl->reader->GetSize();
 			size_t endoffs = start_pos + len;
 			ch.Load();
 
-			if (_sl.reader->GetSize() != endoffs) {
-				SlErrorCorruptFmt("Invalid chunk size in RIFF in {} - expected {}, got {}", ch.GetName(), len, _sl.reader->GetSize() - start_pos);
+			if (_sl->reader->GetSize() != endoffs) {
+				SlErrorCorruptFmt("Invalid chunk size in RIFF in {} - expected {}, got {}", ch.GetName(), len, _sl->reader->GetSize() - start_pos);
 			}
 			break;
 		}
@@ -2017,7 +2117,7 @@ static void SlLoadChunk(const ChunkHandler &ch)
 			break;
 	}
 
-	if (_sl.expect_table_header) SlErrorCorrupt("Table chunk without header");
+	if (_sl->expect_table_header) SlErrorCorrupt("Table chunk without header");
 }
 
 /**
@@ -2029,20 +2129,20 @@ static void SlLoadCheckChunk(const ChunkHandler &ch)
 {
 	uint8_t m = SlReadByte();
 
-	_sl.block_mode = m & CH_TYPE_MASK;
-	_sl.obj_len = 0;
-	_sl.expect_table_header = (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE);
+	_sl->block_mode = m & CH_TYPE_MASK;
+	_sl->obj_len = 0;
+	_sl->expect_table_header = (_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE);
 
 	/* The header should always be at the start. Read the length; the
 	 * LoadCheck() should as first action process the header. */
-	if (_sl.expect_table_header) {
+	if (_sl->expect_table_header) {
 		SlIterateArray();
 	}
 
-	switch (_sl.block_mode) {
+	switch (_sl->block_mode) {
 		case CH_TABLE:
 		case CH_ARRAY:
-			_sl.array_index = 0;
+			_sl->array_index = 0;
 			ch.LoadCheck();
 			break;
 		case CH_SPARSE_TABLE:
@@ -2053,13 +2153,13 @@ static void SlLoadCheckChunk(const ChunkHandler &ch)
 			/* Read length */
 			size_t len = (SlReadByte() << 16) | ((m >> 4) << 24);
 			len += SlReadUint16();
-			_sl.obj_len = len;
-			size_t start_pos = _sl.reader->GetSize();
+			_sl->obj_len = len;
+			size_t start_pos = _sl->reader->GetSize();
 			size_t endoffs = start_pos + len;
 			ch.LoadCheck(len);
 
-			if (_sl.reader->GetSize() != endoffs) {
-				SlErrorCorruptFmt("Invalid chunk size in RIFF in {} - expected {}, got {}", ch.GetName(), len, _sl.reader->GetSize() - start_pos);
+			if (_sl->reader->GetSize() != endoffs) {
+				SlErrorCorruptFmt("Invalid chunk size in RIFF in {} - expected {}, got {}", ch.GetName(), len, _sl->reader->GetSize() - start_pos);
 			}
 			break;
 		}
@@ -2068,60 +2168,196 @@ static void SlLoadCheckChunk(const ChunkHandler &ch)
 			break;
 	}
 
-	if (_sl.expect_table_header) SlErrorCorrupt("Table chunk without header");
+	if (_sl->expect_table_header) SlErrorCorrupt("Table chunk without header");
 }
 
 /**
  * Save a chunk of data (eg. vehicles, stations, etc.). Each chunk is
  * prefixed by an ID identifying it, followed by data, and terminator where appropriate
  * @param ch The chunkhandler that will be used for the operation
+ * @param snapshot Function saving the chunk from its snapshot, or nullptr to save it from the game state.
  */
-static void SlSaveChunk(const ChunkHandler &ch)
+static void SlSaveChunk(const ChunkHandler &ch, const std::function<void()> *snapshot = nullptr)
 {
 	if (ch.type == CH_READONLY) return;
 
+	auto save = [&ch, snapshot]() {
+		if (snapshot != nullptr) {
+			(*snapshot)();
+		} else {
+			ch.Save();
+		}
+	};
+
 	SlWriteUint32(ch.id);
 	Debug(sl, 2, "Saving chunk {}", ch.GetName());
 
-	_sl.block_mode = ch.type;
-	_sl.expect_table_header = (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE);
+	_sl->block_mode = ch.type;
+	_sl->expect_table_header = (_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE);
 
-	_sl.need_length = (_sl.expect_table_header || _sl.block_mode == CH_RIFF) ? NL_WANTLENGTH : NL_NONE;
+	_sl->need_length = (_sl->expect_table_header || _sl->block_mode == CH_RIFF) ? NL_WANTLENGTH : NL_NONE;
 
-	switch (_sl.block_mode) {
+	switch (_sl->block_mode) {
 		case CH_RIFF:
-			ch.Save();
+			save();
 			break;
 		case CH_TABLE:
 		case CH_ARRAY:
-			_sl.last_array_index = 0;
-			SlWriteByte(_sl.block_mode);
-			ch.Save();
+			_sl->last_array_index = 0;
+			SlWriteByte(_sl->block_mode);
+			save();
 			SlWriteArrayLength(0); // Terminate arrays
 			break;
 		case CH_SPARSE_TABLE:
 		case CH_SPARSE_ARRAY:
-			SlWriteByte(_sl.block_mode);
-			ch.Save();
+			SlWriteByte(_sl->block_mode);
+			save();
 			SlWriteArrayLength(0); // Terminate arrays
 			break;
 		default: NOT_REACHED();
 	}
 
-	if (_sl.expect_table_header) SlErrorCorrupt("Table chunk without header");
+	if (_sl->expect_table_header) SlErrorCorrupt("Table chunk without header");
+}
+
+/**
+ * Do saveload work using its own saveload parameters, so it can be done besides the thread owning the current parameters.
+ * Errors are not raised, but returned so the owning thread can raise them.
+ * @param action The action to do the work as.
+ * @param func The work to do.
+ * @return The error message and its details when the work failed, otherwise #INVALID_STRING_ID.
+ */
+static std::pair<StringID, std::string> SlRunSeparately(SaveLoadAction action, const std::function<void()> &func)
+{
+	SaveLoadParams params{};
+	params.action = action;
+	params.separate = true;
+
+	std::pair<StringID, std::string> error = { INVALID_STRING_ID, {} };
+	SaveLoadParams *old_params = _sl;
+	_sl = &params;
+	try {
+		func();
+	} catch (...) {
+		error = { params.error_str, params.extra_msg };
+	}
+	_sl = old_params;
+
+	return error;
+}
+
+/**
+ * Save a chunk into its own dumper, using its own saveload parameters, so it can be saved besides the game thread.
+ * @param ch The chunk handler.
+ * @param snapshot Function saving the chunk from its snapshot, or nullptr to save it from the game state.
+ * @param[out] error The error message and its details when saving failed.
+ * @return The dumper with the saved chunk, or nullptr when saving failed.
+ */
+static std::unique_ptr<MemoryDumper> SlSaveChunkSeparately(const ChunkHandler &ch, const std::function<void()> *snapshot, std::pair<StringID, std::string> &error)
+{
+	std::unique_ptr<MemoryDumper> dumper;
+	error = SlRunSeparately(SLA_SAVE, [&]() {
+		_sl->dumper = std::make_unique<MemoryDumper>();
+		SlSaveChunk(ch, snapshot);
+		dumper = std::move(_sl->dumper);
+	});
+	return dumper;
+}
+
+/**
+ * Save the chunks that can be saved concurrently on the worker threads, each into its own dumper.
+ * @param snapshots For every chunk handler the function saving it from its snapshot, if any; those chunks are not saved here.
+ * @return For every chunk handler the dumper with the saved chunk, or nullptr when it has to be saved on this thread.
+ */
+static std::vector<std::unique_ptr<MemoryDumper>> SlSaveConcurrentChunks(const std::vector<std::function<void()>> &snapshots)
+{
+	const std::vector<ChunkHandlerRef> &handlers = ChunkHandlers();
+	std::vector<std::unique_ptr<MemoryDumper>> dumpers(handlers.size());
+	if (!_settings_client.gui.threaded_game_loop || ThreadPool::Get().GetWorkerCount() == 0) return dumpers;
+
+	std::vector<size_t> concurrent;
+	for (size_t i = 0; i < handlers.size(); i++) {
+		if (handlers[i].get().type != CH_READONLY && snapshots[i] == nullptr && handlers[i].get().CanSaveConcurrently()) concurrent.push_back(i);
+	}
+	if (concurrent.size() < 2) return dumpers;
+
+	/* The errors of the chunks, so the first one in saving order can be raised on this thread. */
+	std::vector<std::pair<StringID, std::string>> errors(concurrent.size(), { INVALID_STRING_ID, {} });
+
+	ThreadPool::Get().ParallelFor(concurrent.size(), 1, [&](size_t first, size_t last) {
+		for (size_t i = first; i < last; i++) {
+			dumpers[concurrent[i]] = SlSaveChunkSeparately(handlers[concurrent[i]], nullptr, errors[i]);
+		}
+	});
+
+	for (const auto &[error_str, extra_msg] : errors) {
+		if (error_str != INVALID_STRING_ID) SlError(error_str, extra_msg);
+	}
+
+	return dumpers;
 }
 
-/** Save all chunks */
-static void SlSaveChunks()
+/**
+ * Save all chunks.
+ * Chunks that only read state no other chunk writes are saved concurrently first, and then
+ * copied into the savegame in between the others, so the savegame does not depend on it.
+ * @param snapshot Whether chunks that support it are only captured now, to be saved when the savegame is written.
+ */
+static void SlSaveChunks(bool snapshot)
 {
-	for (auto &ch : ChunkHandlers()) {
-		SlSaveChunk(ch);
+	const std::vector<ChunkHandlerRef> &handlers = ChunkHandlers();
+
+	std::vector<std::function<void()>> snapshots(handlers.size());
+	if (snapshot) {
+		for (size_t i = 0; i < handlers.size(); i++) {
+			if (handlers[i].get().type != CH_READONLY) snapshots[i] = handlers[i].get().Snapshot();
+		}
+	}
+
+	std::vector<std::unique_ptr<MemoryDumper>> dumpers = SlSaveConcurrentChunks(snapshots);
+
+	for (size_t i = 0; i < handlers.size(); i++) {
+		if (handlers[i].get().type == CH_READONLY) continue;
+
+		_sl->chunks.push_back({ _sl->dumper->GetSize(), &handlers[i].get(), std::move(snapshots[i]) });
+		/* Chunks with a snapshot are saved when the savegame is written. */
+		if (_sl->chunks.back().snapshot != nullptr) continue;
+
+		if (dumpers[i] != nullptr) {
+			_sl->dumper->Append(*dumpers[i]);
+			dumpers[i].reset();
+		} else {
+			SlSaveChunk(handlers[i]);
+		}
 	}
 
 	/* Terminator */
 	SlWriteUint32(0);
 }
 
+/**
+ * Write the savegame from memory into the filter, saving the chunks with a snapshot in between.
+ * @param writer The filter to write to.
+ */
+static void SlWriteSavegame(SaveFilter &writer)
+{
+	size_t pos = 0;
+	for (const SaveLoadParams::SavedChunk &chunk : _sl->chunks) {
+		_sl->dumper->WriteTo(writer, pos, chunk.offset);
+		pos = chunk.offset;
+		writer.StartChunk(chunk.ch->id);
+		if (chunk.snapshot == nullptr) continue;
+
+		std::pair<StringID, std::string> error;
+		std::unique_ptr<MemoryDumper> dumper = SlSaveChunkSeparately(*chunk.ch, &chunk.snapshot, error);
+		if (dumper == nullptr) SlError(error.first, error.second);
+		dumper->WriteTo(writer, 0, dumper->GetSize());
+	}
+	_sl->dumper->WriteTo(writer, pos, _sl->dumper->GetSize());
+
+	writer.Finish();
+}
+
 /**
  * Find the ChunkHandler that will be used for processing the found
  * chunk in the savegame or in memory
@@ -2167,14 +2403,14 @@ static void SlLoadCheckChunks()
 /** Fix all pointers (convert index -> pointer) */
 static void SlFixPointers()
 {
-	_sl.action = SLA_PTRS;
+	_sl->action = SLA_PTRS;
 
 	for (const ChunkHandler &ch : ChunkHandlers()) {
 		Debug(sl, 3, "Fixing pointers for {}", ch.GetName());
 		ch.FixPointers();
 	}
 
-	assert(_sl.action == SLA_PTRS);
+	assert(_sl->action == SLA_PTRS);
 }
 
 
@@ -2623,6 +2859,119 @@ struct LZMASaveFilter : SaveFilter {
 
 #endif /* WITH_LIBLZMA */
 
+/********************************************
+ ********** START OF ZSTD CODE **************
+ ********************************************/
+
+#if defined(WITH_ZSTD)
+#include <zstd.h>
+
+/** Filter using Zstandard decompression. */
+struct ZstdLoadFilter : LoadFilter {
+	ZSTD_DStream *zstd;                   ///< Stream state that we are reading from.
+	ZSTD_inBuffer input;                  ///< The part of #fread_buf that is not decompressed yet.
+	uint8_t fread_buf[MEMORY_CHUNK_SIZE]; ///< Buffer for reading from the file.
+
+	/**
+	 * Initialise this filter.
+	 * @param chain The next filter in this chain.
+	 */
+	ZstdLoadFilter(std::shared_ptr<LoadFilter> chain) : LoadFilter(chain), zstd(ZSTD_createDStream()), input({ this->fread_buf, 0, 0 })
+	{
+		if (this->zstd == nullptr) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "cannot initialize decompressor");
+	}
+
+	/** Clean everything up. */
+	~ZstdLoadFilter()
+	{
+		ZSTD_freeDStream(this->zstd);
+	}
+
+	size_t Read(uint8_t *buf, size_t size) override
+	{
+		ZSTD_outBuffer output = { buf, size, 0 };
+
+		while (output.pos != output.size) {
+			/* read more bytes from the file? */
+			if (this->input.pos == this->input.size) {
+				this->input.size = this->chain->Read(this->fread_buf, sizeof(this->fread_buf));
+				this->input.pos = 0;
+			}
+
+			size_t decompressed = output.pos;
+			size_t r = ZSTD_decompressStream(this->zstd, &output, &this->input);
+			if (ZSTD_isError(r)) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "libzstd returned error code");
+
+			/* The file has ended, and the decompressor has nothing left either. */
+			if (this->input.size == 0 && output.pos == decompressed) break;
+		}
+
+		return output.pos;
+	}
+};
+
+/** Filter using Zstandard compression. */
+struct ZstdSaveFilter : SaveFilter {
+	ZSTD_CCtx *zstd;                       ///< Stream state that we are writing to.
+	uint8_t fwrite_buf[MEMORY_CHUNK_SIZE]; ///< Buffer for writing to the file.
+
+	/**
+	 * Initialise this filter.
+	 * @param chain             The next filter in this chain.
+	 * @param compression_level The requested level of compression.
+	 */
+	ZstdSaveFilter(std::shared_ptr<SaveFilter> chain, uint8_t compression_level) : SaveFilter(chain), zstd(ZSTD_createCCtx())
+	{
+		if (this->zstd == nullptr || ZSTD_isError(ZSTD_CCtx_setParameter(this->zstd, ZSTD_c_compressionLevel, compression_level))) {
+			SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "cannot initialize compressor");
+		}
+
+		/* Without multithreading support in libzstd this fails, and everything is compressed on this thread. */
+		if (_savegame_compression_workers > 0 && ZSTD_isError(ZSTD_CCtx_setParameter(this->zstd, ZSTD_c_nbWorkers, _savegame_compression_workers))) {
+			Debug(sl, 1, "Cannot compress savegame with {} workers, compressing on the savegame thread", _savegame_compression_workers);
+		}
+	}
+
+	/** Clean up what we allocated. */
+	~ZstdSaveFilter()
+	{
+		ZSTD_freeCCtx(this->zstd);
+	}
+
+	/**
+	 * Helper loop for writing the data.
+	 * @param p    The bytes to write.
+	 * @param len  Amount of bytes to write.
+	 * @param mode Mode for ZSTD_compressStream2.
+	 */
+	void WriteLoop(uint8_t *p, size_t len, ZSTD_EndDirective mode)
+	{
+		ZSTD_inBuffer input = { p, len, 0 };
+		size_t remaining;
+		do {
+			ZSTD_outBuffer output = { this->fwrite_buf, sizeof(this->fwrite_buf), 0 };
+			remaining = ZSTD_compressStream2(this->zstd, &output, &input, mode);
+			if (ZSTD_isError(remaining)) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "libzstd returned error code");
+
+			/* Write the compressed data to the file. */
+			if (output.pos != 0) this->chain->Write(this->fwrite_buf, output.pos);
+		} while (mode == ZSTD_e_end ? remaining != 0 : input.pos != input.size);
+	}
+
+	void Write(uint8_t *buf, size_t size) override
+	{
+		this->WriteLoop(buf, size, ZSTD_e_continue);
+	}
+
+	void Finish() override
+	{
+		this->WriteLoop(nullptr, 0, ZSTD_e_end);
+		this->chain->Finish();
+	}
+};
+
+#endif /* WITH_ZSTD */
+
 /*******************************************
  ************* END OF CODE *****************
  *******************************************/
@@ -2644,6 +2993,306 @@ static const uint32_t SAVEGAME_TAG_LZO = TO_BE32X('OTTD');
 static const uint32_t SAVEGAME_TAG_NONE = TO_BE32X('OTTN');
 static const uint32_t SAVEGAME_TAG_ZLIB = TO_BE32X('OTTZ');
 static const uint32_t SAVEGAME_TAG_LZMA = TO_BE32X('OTTX');
+static const uint32_t SAVEGAME_TAG_ZSTD = TO_BE32X('OTTS');
+static const uint32_t SAVEGAME_TAG_BLOCKS = TO_BE32X('OTTB');
+
+/********************************************
+ ************* START OF BLOCKS **************
+ ********************************************/
+
+/** Number of uncompressed bytes in each block of a savegame that is written as blocks. */
+static const size_t SAVEGAME_BLOCK_SIZE = 4 * 1024 * 1024;
+/** Maximum number of compressed bytes of a block; none of the formats expands a block by more than an eighth. */
+static const size_t SAVEGAME_MAX_COMPRESSED_BLOCK_SIZE = SAVEGAME_BLOCK_SIZE + SAVEGAME_BLOCK_SIZE / 8;
+
+/** Filter to compress a single block of the savegame into memory. */
+struct MemorySaveFilter : SaveFilter {
+	std::vector<uint8_t> &buffer; ///< The memory to write to.
+
+	/**
+	 * Initialise this filter.
+	 * @param buffer The memory to write to.
+	 */
+	MemorySaveFilter(std::vector<uint8_t> &buffer) : SaveFilter(nullptr), buffer(buffer)
+	{
+	}
+
+	void Write(uint8_t *buf, size_t size) override
+	{
+		this->buffer.insert(this->buffer.end(), buf, buf + size);
+	}
+
+	void Finish() override
+	{
+	}
+};
+
+/** Filter to decompress a single block of the savegame from memory. */
+struct MemoryLoadFilter : LoadFilter {
+	const std::vector<uint8_t> &buffer; ///< The memory to read from.
+	size_t pos = 0;                     ///< The position to read from next.
+
+	/**
+	 * Initialise this filter.
+	 * @param buffer The memory to read from.
+	 */
+	MemoryLoadFilter(const std::vector<uint8_t> &buffer) : LoadFilter(nullptr), buffer(buffer)
+	{
+	}
+
+	size_t Read(uint8_t *buf, size_t size) override
+	{
+		size = std::min(size, this->buffer.size() - this->pos);
+		std::copy_n(this->buffer.data() + this->pos, size, buf);
+		this->pos += size;
+		return size;
+	}
+
+	void Reset() override
+	{
+		this->pos = 0;
+	}
+};
+
+/** A block of the savegame that is compressed or decompressed by the thread pool. */
+struct SavegameBlock {
+	std::vector<uint8_t> compressed;        ///< The block as it is stored in the savegame.
+	std::vector<uint8_t> uncompressed;      ///< The block as it is read by the chunk handlers.
+	std::pair<StringID, std::string> error; ///< The error of the (de)compression, if it failed.
+	std::future<void> done;                 ///< Ready once the (de)compression has finished.
+
+	/** Wait till the block has been (de)compressed, and raise the error of the (de)compression here. */
+	void Wait()
+	{
+		this->done.get();
+		if (this->error.first != INVALID_STRING_ID) SlError(this->error.first, this->error.second);
+	}
+};
+
+/**
+ * Get the number of blocks that may be decompressed at the same time while loading.
+ * @return One more than there are workers, so a block is ready when the previous one has been handled.
+ */
+static size_t GetMaxPendingSavegameBlocks()
+{
+	return ThreadPool::Get().GetWorkerCount() + 1;
+}
+
+/**
+ * Get the number of blocks that may be compressed in the background while saving.
+ * Saving runs alongside the game, so compressing blocks must not keep all workers busy
+ * while the game loop wants them for its short work.
+ * @return Half the number of workers; 0 to compress the blocks on the saving thread itself.
+ */
+static size_t GetMaxPendingSavegameSaveBlocks()
+{
+	return ThreadPool::Get().GetWorkerCount() / 2;
+}
+
+/**
+ * Filter that splits the savegame into blocks which are compressed independently, in parallel.
+ * The blocks follow the tag of the format they are compressed with; each has the big endian 32 bits
+ * compressed and uncompressed size in front of it. A compressed size of 0 ends the blocks, after which
+ * the number of chunks and per chunk its tag and 64 bits uncompressed offset follow. The last 32 bits
+ * are the size of that index, so a reader can find any chunk by reading from the end of the savegame.
+ */
+struct BlockSaveFilter : SaveFilter {
+	const SaveLoadFormat &format;                           ///< The format to compress the blocks with.
+	uint8_t compression;                                    ///< The compression level to use.
+	std::vector<uint8_t> buffer;                            ///< The block that is being filled.
+	std::deque<std::unique_ptr<SavegameBlock>> pending;     ///< The blocks being compressed, in savegame order.
+	std::vector<std::pair<uint32_t, uint64_t>> chunks;      ///< The tag and uncompressed offset of each chunk.
+	uint64_t position = 0;                                  ///< The uncompressed number of bytes written so far.
+
+	/**
+	 * Initialise this filter.
+	 * @param chain       The next filter in this chain.
+	 * @param format      The format to compress the blocks with.
+	 * @param compression The compression level to use.
+	 */
+	BlockSaveFilter(std::shared_ptr<SaveFilter> chain, const SaveLoadFormat &format, uint8_t compression) : SaveFilter(chain), format(format), compression(compression)
+	{
+		this->buffer.reserve(SAVEGAME_BLOCK_SIZE);
+		uint32_t tag = format.tag;
+		this->chain->Write((uint8_t *)&tag, sizeof(tag));
+	}
+
+	/** Wait till the thread pool is done with our blocks, as they are about to be freed. */
+	~BlockSaveFilter()
+	{
+		for (auto &block : this->pending) block->done.wait();
+	}
+
+	/**
+	 * Write a number in big endian to the next filter.
+	 * @param value The number to write.
+	 */
+	void WriteUint32(uint32_t value)
+	{
+		value = TO_BE32(value);
+		this->chain->Write((uint8_t *)&value, sizeof(value));
+	}
+
+	/** Start compressing the filled block, and write blocks to the next filter when too many are pending. */
+	void CompressBlock()
+	{
+		auto block = std::make_unique<SavegameBlock>();
+		block->uncompressed.swap(this->buffer);
+		this->buffer.reserve(SAVEGAME_BLOCK_SIZE);
+
+		auto compress = [b = block.get(), &format = this->format, compression = this->compression]() {
+			b->error = SlRunSeparately(SLA_SAVE, [&]() {
+				std::shared_ptr<SaveFilter> filter = format.init_write(std::make_shared<MemorySaveFilter>(b->compressed), compression);
+				filter->Write(b->uncompressed.data(), b->uncompressed.size());
+				filter->Finish();
+			});
+		};
+
+		const size_t max_pending = GetMaxPendingSavegameSaveBlocks();
+		if (max_pending == 0) {
+			compress();
+			std::promise<void> done;
+			done.set_value();
+			block->done = done.get_future();
+		} else {
+			block->done = ThreadPool::Get().Submit(std::move(compress));
+		}
+		this->pending.push_back(std::move(block));
+
+		while (this->pending.size() > max_pending) this->WriteBlock();
+	}
+
+	/** Wait for the oldest pending block to be compressed, and write it to the next filter. */
+	void WriteBlock()
+	{
+		std::unique_ptr<SavegameBlock> block = std::move(this->pending.front());
+		this->pending.pop_front();
+		block->Wait();
+
+		this->WriteUint32(static_cast<uint32_t>(block->compressed.size()));
+		this->WriteUint32(static_cast<uint32_t>(block->uncompressed.size()));
+		this->chain->Write(block->compressed.data(), block->compressed.size());
+	}
+
+	void Write(uint8_t *buf, size_t size) override
+	{
+		this->position += size;
+		while (size > 0) {
+			size_t to_copy = std::min(SAVEGAME_BLOCK_SIZE - this->buffer.size(), size);
+			this->buffer.insert(this->buffer.end(), buf, buf + to_copy);
+			buf += to_copy;
+			size -= to_copy;
+
+			if (this->buffer.size() == SAVEGAME_BLOCK_SIZE) this->CompressBlock();
+		}
+	}
+
+	void StartChunk(uint32_t id) override
+	{
+		this->chunks.emplace_back(id, this->position);
+	}
+
+	void Finish() override
+	{
+		if (!this->buffer.empty()) this->CompressBlock();
+		while (!this->pending.empty()) this->WriteBlock();
+
+		this->WriteUint32(0);
+		this->WriteUint32(static_cast<uint32_t>(this->chunks.size()));
+		for (const auto &[id, offset] : this->chunks) {
+			this->WriteUint32(id);
+			this->WriteUint32(static_cast<uint32_t>(offset >> 32));
+			this->WriteUint32(static_cast<uint32_t>(offset));
+		}
+		this->WriteUint32(static_cast<uint32_t>(sizeof(uint32_t) + this->chunks.size() * (sizeof(uint32_t) + sizeof(uint64_t))));
+
+		this->chain->Finish();
+	}
+};
+
+/** Filter that reads a savegame written by #BlockSaveFilter, decompressing the blocks ahead in parallel. */
+struct BlockLoadFilter : LoadFilter {
+	const SaveLoadFormat *format;                       ///< The format the blocks are compressed with.
+	std::deque<std::unique_ptr<SavegameBlock>> pending; ///< The blocks being decompressed, in savegame order.
+	std::unique_ptr<SavegameBlock> current;             ///< The block that is being read.
+	size_t pos = 0;                                     ///< The position in the current block to read from next.
+	bool last_block_read = false;                       ///< Whether the end of the blocks has been reached.
+
+	BlockLoadFilter(std::shared_ptr<LoadFilter> chain);
+
+	/** Wait till the thread pool is done with our blocks, as they are about to be freed. */
+	~BlockLoadFilter()
+	{
+		for (auto &block : this->pending) block->done.wait();
+	}
+
+	/**
+	 * Read a big endian number from the next filter.
+	 * @return The number.
+	 */
+	uint32_t ReadUint32()
+	{
+		uint32_t value;
+		if (this->chain->Read((uint8_t *)&value, sizeof(value)) != sizeof(value)) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
+		return FROM_BE32(value);
+	}
+
+	/** Read the next blocks from the next filter and start decompressing them, till enough are pending. */
+	void ReadBlocks()
+	{
+		while (!this->last_block_read && this->pending.size() < GetMaxPendingSavegameBlocks()) {
+			uint32_t compressed_size = this->ReadUint32();
+			if (compressed_size == 0) {
+				/* The index of the chunks follows, which is not needed when reading the whole savegame. */
+				this->last_block_read = true;
+				break;
+			}
+			if (compressed_size > SAVEGAME_MAX_COMPRESSED_BLOCK_SIZE) SlErrorCorrupt("Invalid compressed savegame block size");
+			uint32_t uncompressed_size = this->ReadUint32();
+			if (uncompressed_size == 0 || uncompressed_size > SAVEGAME_BLOCK_SIZE) SlErrorCorrupt("Invalid savegame block size");
+
+			auto block = std::make_unique<SavegameBlock>();
+			block->compressed.resize(compressed_size);
+			if (this->chain->Read(block->compressed.data(), compressed_size) != compressed_size) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
+			block->uncompressed.resize(uncompressed_size);
+
+			block->done = ThreadPool::Get().Submit([b = block.get(), format = this->format]() {
+				/* Only the blocks are loaded here, so there are no pointers to clear on failure. */
+				b->error = SlRunSeparately(SLA_NULL, [&]() {
+					std::shared_ptr<LoadFilter> filter = format->init_load(std::make_shared<MemoryLoadFilter>(b->compressed));
+					if (filter->Read(b->uncompressed.data(), b->uncompressed.size()) != b->uncompressed.size()) SlErrorCorrupt("Savegame block is too short");
+				});
+			});
+			this->pending.push_back(std::move(block));
+		}
+	}
+
+	size_t Read(uint8_t *buf, size_t size) override
+	{
+		size_t read = 0;
+		while (read < size) {
+			if (this->current == nullptr || this->pos == this->current->uncompressed.size()) {
+				this->ReadBlocks();
+				if (this->pending.empty()) break;
+
+				this->current = std::move(this->pending.front());
+				this->pending.pop_front();
+				this->current->Wait();
+				this->pos = 0;
+			}
+
+			size_t to_copy = std::min(size - read, this->current->uncompressed.size() - this->pos);
+			std::copy_n(this->current->uncompressed.data() + this->pos, to_copy, buf + read);
+			this->pos += to_copy;
+			read += to_copy;
+		}
+		return read;
+	}
+};
+
+/********************************************
+ ************** END OF BLOCKS ***************
+ ********************************************/
 
 /** The different saveload formats known/understood by OpenTTD. */
 static const SaveLoadFormat _saveload_formats[] = {
@@ -2663,6 +3312,14 @@ static const SaveLoadFormat _saveload_formats[] = {
 #else
 	{"zlib", SAVEGAME_TAG_ZLIB, nullptr,                            nullptr,                            0, 0, 0},
 #endif
+#if defined(WITH_ZSTD)
+	/* Around level 9 savegames are about as small as with LZMA level 2, but they load several times faster. Higher levels
+	 * mostly cost time; the compression can be spread over worker threads with the savegame_compression_workers setting.
+	 * It comes before LZMA, so LZMA stays the default and savegames stay loadable without libzstd, unless chosen otherwise. */
+	{"zstd", SAVEGAME_TAG_ZSTD, CreateLoadFilter<ZstdLoadFilter>,   CreateSaveFilter<ZstdSaveFilter>,   1, 9, 19},
+#else
+	{"zstd", SAVEGAME_TAG_ZSTD, nullptr,                            nullptr,                            0, 0, 0},
+#endif
 #if defined(WITH_LIBLZMA)
 	/* Level 2 compression is speed wise as fast as zlib level 6 compression (old default), but results in ~10% smaller saves.
 	 * Higher compression levels are possible, and might improve savegame size by up to 25%, but are also up to 10 times slower.
@@ -2673,8 +3330,25 @@ static const SaveLoadFormat _saveload_formats[] = {
 #else
 	{"lzma", SAVEGAME_TAG_LZMA, nullptr,                            nullptr,                            0, 0, 0},
 #endif
+	/* Not a compression of its own, but blocks in one of the formats above. It is written by the savegame_blocks setting. */
+	{"blocks", SAVEGAME_TAG_BLOCKS, CreateLoadFilter<BlockLoadFilter>, nullptr,                         0, 0, 0},
 };
 
+/**
+ * Initialise this filter, reading the format the blocks are compressed with.
+ * @param chain The next filter in this chain.
+ */
+BlockLoadFilter::BlockLoadFilter(std::shared_ptr<LoadFilter> chain) : LoadFilter(chain)
+{
+	uint32_t tag;
+	if (this->chain->Read((uint8_t *)&tag, sizeof(tag)) != sizeof(tag)) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
+
+	auto fmt = std::find_if(std::begin(_saveload_formats), std::end(_saveload_formats), [tag](const auto &fmt) { return fmt.tag == tag; });
+	if (fmt == std::end(_saveload_formats) || fmt->tag == SAVEGAME_TAG_BLOCKS) SlErrorCorrupt("Unknown savegame block format");
+	if (fmt->init_load == nullptr) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, fmt::format("Loader for '{}' is not available.", fmt->name));
+	this->format = &*fmt;
+}
+
 /**
  * Return the savegameformat of the game. Whether it was created with ZLIB compression
  * uncompressed, or another type
@@ -2721,6 +3395,66 @@ static std::pair<const SaveLoadFormat &, uint8_t> GetSavegameFormat(const std::s
 	return {def, def.default_compression};
 }
 
+/**
+ * Create a filter that writes the savegame as blocks that are compressed in parallel.
+ * @param chain  The next filter in this chain.
+ * @param format Name and optionally compression level of the format to compress the blocks with, like #_savegame_format.
+ * @return The filter.
+ */
+std::shared_ptr<SaveFilter> CreateBlockSaveFilter(std::shared_ptr<SaveFilter> chain, const std::string &format)
+{
+	auto [fmt, compression] = GetSavegameFormat(format);
+	return std::make_shared<BlockSaveFilter>(chain, fmt, compression);
+}
+
+/**
+ * Create a filter that reads a savegame written by #CreateBlockSaveFilter.
+ * @param chain The next filter in this chain, positioned after the savegame header.
+ * @return The filter.
+ */
+std::shared_ptr<LoadFilter> CreateBlockLoadFilter(std::shared_ptr<LoadFilter> chain)
+{
+	return std::make_shared<BlockLoadFilter>(chain);
+}
+
+/**
+ * Get the savegame formats that can be loaded.
+ * @return The tags of the formats.
+ */
+std::vector<uint32_t> GetLoadableSavegameFormats()
+{
+	std::vector<uint32_t> tags;
+	for (const auto &slf : _saveload_formats) {
+		if (slf.init_load != nullptr) tags.push_back(slf.tag);
+	}
+	return tags;
+}
+
+/**
+ * Get the format to write a savegame in that has to be loaded with a limited set of formats, like by a network client.
+ * @param loadable The tags of the formats the savegame can be loaded with.
+ * @return The configured format if it can be loaded, otherwise the default format of those that can be loaded.
+ */
+std::string GetSavegameFormatLoadableWith(const std::vector<uint32_t> &loadable)
+{
+	auto can_load = [&loadable](const SaveLoadFormat &slf) { return slf.init_write != nullptr && std::find(loadable.begin(), loadable.end(), slf.tag) != loadable.end(); };
+
+	if (can_load(GetSavegameFormat(_savegame_format).first)) return _savegame_format;
+
+	auto it = std::find_if(std::rbegin(_saveload_formats), std::rend(_saveload_formats), can_load);
+	return it != std::rend(_saveload_formats) ? it->name : "none";
+}
+
+/**
+ * Check whether a savegame that has to be loaded with a limited set of formats, like by a network client, can be written as blocks.
+ * @param loadable The tags of the formats the savegame can be loaded with.
+ * @return True iff blocks are enabled by #_savegame_blocks and can be loaded.
+ */
+bool CanWriteSavegameBlocksLoadableWith(const std::vector<uint32_t> &loadable)
+{
+	return _savegame_blocks && std::find(loadable.begin(), loadable.end(), SAVEGAME_TAG_BLOCKS) != loadable.end();
+}
+
 /* actual loader/saver function */
 void InitializeGame(uint size_x, uint size_y, bool reset_date, bool reset_settings);
 extern bool AfterLoadGame();
@@ -2741,10 +3475,11 @@ static void ResetSaveloadData()
  */
 static inline void ClearSaveLoadState()
 {
-	_sl.dumper = nullptr;
-	_sl.sf = nullptr;
-	_sl.reader = nullptr;
-	_sl.lf = nullptr;
+	_sl->dumper = nullptr;
+	_sl->chunks.clear();
+	_sl->sf = nullptr;
+	_sl->reader = nullptr;
+	_sl->lf = nullptr;
 }
 
 /** Update the gui accordingly when starting saving and set locks on saveload. */
@@ -2753,7 +3488,7 @@ static void SaveFileStart()
 	SetMouseCursorBusy(true);
 
 	InvalidateWindowData(WC_STATUS_BAR, 0, SBI_SAVELOAD_START);
-	_sl.saveinprogress = true;
+	_sl->saveinprogress = true;
 }
 
 /** Update the gui accordingly when saving is done and release locks on saveload. */
@@ -2762,7 +3497,7 @@ static void SaveFileDone()
 	SetMouseCursorBusy(false);
 
 	InvalidateWindowData(WC_STATUS_BAR, 0, SBI_SAVELOAD_FINISH);
-	_sl.saveinprogress = false;
+	_sl->saveinprogress = false;
 
 #ifdef __EMSCRIPTEN__
 	EM_ASM(if (window["openttd_syncfs"]) openttd_syncfs());
@@ -2772,20 +3507,20 @@ static void SaveFileDone()
 /** Set the error message from outside of the actual loading/saving of the game (AfterLoadGame and friends) */
 void SetSaveLoadError(StringID str)
 {
-	_sl.error_str = str;
+	_sl->error_str = str;
 }
 
 /** Return the appropriate initial string for an error depending on whether we are saving or loading. */
 StringID GetSaveLoadErrorType()
 {
-	return _sl.action == SLA_SAVE ? STR_ERROR_GAME_SAVE_FAILED : STR_ERROR_GAME_LOAD_FAILED;
+	return _sl->action == SLA_SAVE ? STR_ERROR_GAME_SAVE_FAILED : STR_ERROR_GAME_LOAD_FAILED;
 }
 
 /** Return the description of the error. **/
 StringID GetSaveLoadErrorMessage()
 {
-	SetDParamStr(0, _sl.extra_msg);
-	return _sl.error_str;
+	SetDParamStr(0, _sl->extra_msg);
+	return _sl->error_str;
 }
 
 /** Show a gui message when saving has failed */
@@ -2802,14 +3537,18 @@ static void SaveFileError()
 static SaveOrLoadResult SaveFileToDisk(bool threaded)
 {
 	try {
-		auto [fmt, compression] = GetSavegameFormat(_savegame_format);
+		auto [fmt, compression] = GetSavegameFormat(_sl->format);
 
 		/* We have written our stuff to memory, now write it to file! */
-		uint32_t hdr[2] = { fmt.tag, TO_BE32(SAVEGAME_VERSION << 16) };
-		_sl.sf->Write((uint8_t*)hdr, sizeof(hdr));
+		uint32_t hdr[2] = { _sl->blocks ? SAVEGAME_TAG_BLOCKS : fmt.tag, TO_BE32(SAVEGAME_VERSION << 16) };
+		_sl->sf->Write((uint8_t*)hdr, sizeof(hdr));
 
-		_sl.sf = fmt.init_write(_sl.sf, compression);
-		_sl.dumper->Flush(_sl.sf);
+		if (_sl->blocks) {
+			_sl->sf = std::make_shared<BlockSaveFilter>(_sl->sf, fmt, compression);
+		} else {
+			_sl->sf = fmt.init_write(_sl->sf, compression);
+		}
+		SlWriteSavegame(*_sl->sf);
 
 		ClearSaveLoadState();
 
@@ -2823,7 +3562,7 @@ static SaveOrLoadResult SaveFileToDisk(bool threaded)
 
 		/* We don't want to shout when saving is just
 		 * cancelled due to a client disconnecting. */
-		if (_sl.error_str != STR_NETWORK_ERROR_LOSTCONNECTION) {
+		if (_sl->error_str != STR_NETWORK_ERROR_LOSTCONNECTION) {
 			/* Skip the "colour" character */
 			Debug(sl, 0, "{}", GetString(GetSaveLoadErrorType()).substr(3) + GetString(GetSaveLoadErrorMessage()));
 			asfp = SaveFileError;
@@ -2854,19 +3593,24 @@ void WaitTillSaved()
  * using the writer, either in threaded mode if possible, or single-threaded.
  * @param writer   The filter to write the savegame to.
  * @param threaded Whether to try to perform the saving asynchronously.
+ * @param format   The format to write the savegame in, like #_savegame_format.
+ * @param blocks   Whether to write the savegame as independently compressed blocks, like #_savegame_blocks.
  * @return Return the result of the action. #SL_OK or #SL_ERROR
  */
-static SaveOrLoadResult DoSave(std::shared_ptr<SaveFilter> writer, bool threaded)
+static SaveOrLoadResult DoSave(std::shared_ptr<SaveFilter> writer, bool threaded, const std::string &format, bool blocks)
 {
-	assert(!_sl.saveinprogress);
+	assert(!_sl->saveinprogress);
 
-	_sl.dumper = std::make_unique<MemoryDumper>();
-	_sl.sf = writer;
+	_sl->dumper = std::make_unique<MemoryDumper>();
+	_sl->sf = writer;
+	_sl->format = format;
+	_sl->blocks = blocks;
 
 	_sl_version = SAVEGAME_VERSION;
 
 	SaveViewportBeforeSaveGame();
-	SlSaveChunks();
+	/* When writing happens on another thread, let the chunks that can be saved from a snapshot be saved there. */
+	SlSaveChunks(threaded);
 
 	SaveFileStart();
 
@@ -2886,13 +3630,15 @@ static SaveOrLoadResult DoSave(std::shared_ptr<SaveFilter> writer, bool threaded
  * Save the game using a (writer) filter.
  * @param writer   The filter to write the savegame to.
  * @param threaded Whether to try to perform the saving asynchronously.
+ * @param format   The format to write the savegame in, like #_savegame_format.
+ * @param blocks   Whether to write the savegame as independently compressed blocks, like #_savegame_blocks.
  * @return Return the result of the action. #SL_OK or #SL_ERROR
  */
-SaveOrLoadResult SaveWithFilter(std::shared_ptr<SaveFilter> writer, bool threaded)
+SaveOrLoadResult SaveWithFilter(std::shared_ptr<SaveFilter> writer, bool threaded, const std::string &format, bool blocks)
 {
 	try {
-		_sl.action = SLA_SAVE;
-		return DoSave(writer, threaded);
+		_sl->action = SLA_SAVE;
+		return DoSave(writer, threaded, format, blocks);
 	} catch (...) {
 		ClearSaveLoadState();
 		return SL_ERROR;
@@ -2927,7 +3673,7 @@ static const SaveLoadFormat *DetermineSaveLoadFormat(uint32_t tag, uint32_t raw_
 	}
 
 	Debug(sl, 0, "Unknown savegame type, trying to load it as the buggy format");
-	_sl.lf->Reset();
+	_sl->lf->Reset();
 	_sl_version = SL_MIN_VERSION;
 	_sl_minor_version = 0;
 
@@ -2950,7 +3696,7 @@ static const SaveLoadFormat *DetermineSaveLoadFormat(uint32_t tag, uint32_t raw_
  */
 static SaveOrLoadResult DoLoad(std::shared_ptr<LoadFilter> reader, bool load_check)
 {
-	_sl.lf = reader;
+	_sl->lf = reader;
 
 	if (load_check) {
 		/* Clear previous check data */
@@ -2960,7 +3706,7 @@ static SaveOrLoadResult DoLoad(std::shared_ptr<LoadFilter> reader, bool load_che
 	}
 
 	uint32_t hdr[2];
-	if (_sl.lf->Read((uint8_t*)hdr, sizeof(hdr)) != sizeof(hdr)) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
+	if (_sl->lf->Read((uint8_t*)hdr, sizeof(hdr)) != sizeof(hdr)) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
 
 	/* see if we have any loader for this type. */
 	const SaveLoadFormat *fmt = DetermineSaveLoadFormat(hdr[0], hdr[1]);
@@ -2970,8 +3716,8 @@ static SaveOrLoadResult DoLoad(std::shared_ptr<LoadFilter> reader, bool load_che
 		SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, fmt::format("Loader for '{}' is not available.", fmt->name));
 	}
 
-	_sl.lf = fmt->init_load(_sl.lf);
-	_sl.reader = std::make_unique<ReadBuffer>(_sl.lf);
+	_sl->lf = fmt->init_load(_sl->lf);
+	_sl->reader = std::make_unique<ReadBuffer>(_sl->lf);
 	_next_offs = 0;
 
 	if (!load_check) {
@@ -3051,7 +3797,7 @@ static SaveOrLoadResult DoLoad(std::shared_ptr<LoadFilter> reader, bool load_che
 SaveOrLoadResult LoadWithFilter(std::shared_ptr<LoadFilter> reader)
 {
 	try {
-		_sl.action = SLA_LOAD;
+		_sl->action = SLA_LOAD;
 		return DoLoad(reader, false);
 	} catch (...) {
 		ClearSaveLoadState();
@@ -3071,7 +3817,7 @@ SaveOrLoadResult LoadWithFilter(std::shared_ptr<LoadFilter> reader)
 SaveOrLoadResult SaveOrLoad(const std::string &filename, SaveLoadOperation fop, DetailedFileType dft, Subdirectory sb, bool threaded)
 {
 	/* An instance of saving is already active, so don't go saving again */
-	if (_sl.saveinprogress && fop == SLO_SAVE && dft == DFT_GAME_FILE && threaded) {
+	if (_sl->saveinprogress && fop == SLO_SAVE && dft == DFT_GAME_FILE && threaded) {
 		/* if not an autosave, but a user action, show error message */
 		if (!_do_autosave) ShowErrorMessage(STR_ERROR_SAVE_STILL_IN_PROGRESS, INVALID_STRING_ID, WL_ERROR);
 		return SL_OK;
@@ -3106,15 +3852,15 @@ SaveOrLoadResult SaveOrLoad(const std::string &filename, SaveLoadOperation fop,
 		assert(dft == DFT_GAME_FILE);
 		switch (fop) {
 			case SLO_CHECK:
-				_sl.action = SLA_LOAD_CHECK;
+				_sl->action = SLA_LOAD_CHECK;
 				break;
 
 			case SLO_LOAD:
-				_sl.action = SLA_LOAD;
+				_sl->action = SLA_LOAD;
 				break;
 
 			case SLO_SAVE:
-				_sl.action = SLA_SAVE;
+				_sl->action = SLA_SAVE;
 				break;
 
 			default: NOT_REACHED();
@@ -3135,7 +3881,7 @@ SaveOrLoadResult SaveOrLoad(const std::string &filename, SaveLoadOperation fop,
 			Debug(desync, 1, "save: {:08x}; {:02x}; {}", TimerGameEconomy::date, TimerGameEconomy::date_fract, filename);
 			if (!_settings_client.gui.threaded_saves) threaded = false;
 
-			return DoSave(std::make_shared<FileWriter>(fh), threaded);
+			return DoSave(std::make_shared<FileWriter>(fh), threaded, _savegame_format, _savegame_blocks);
 		}
 
 		/* LOAD game */
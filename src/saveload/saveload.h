@@ -383,6 +383,7 @@ enum SaveLoadVersion : uint16_t {
 	SLV_GROUP_NUMBERS,                      ///< 336  PR#12297 Add per-company group numbers.
 	SLV_INCREASE_STATION_TYPE_FIELD_SIZE,   ///< 337  PR#12572 Increase size of StationType field in map array
 	SLV_ROAD_WAYPOINTS,                     ///< 338  PR#12572 Road waypoints
+	SLV_LINKGRAPH_JOIN_POSTPONED,           ///< 339  Save whether the join of the link graph jobs that are due is postponed.
 
 	SL_MAX_VERSION,                         ///< Highest possible saveload version
 };
@@ -430,7 +431,11 @@ void DoExitSave();
 
 void DoAutoOrNetsave(FiosNumberedSaveName &counter);
 
-SaveOrLoadResult SaveWithFilter(std::shared_ptr<struct SaveFilter> writer, bool threaded);
+std::vector<uint32_t> GetLoadableSavegameFormats();
+std::string GetSavegameFormatLoadableWith(const std::vector<uint32_t> &loadable);
+bool CanWriteSavegameBlocksLoadableWith(const std::vector<uint32_t> &loadable);
+
+SaveOrLoadResult SaveWithFilter(std::shared_ptr<struct SaveFilter> writer, bool threaded, const std::string &format, bool blocks);
 SaveOrLoadResult LoadWithFilter(std::shared_ptr<struct LoadFilter> reader);
 
 typedef void AutolengthProc(void *arg);
@@ -483,6 +488,20 @@ struct ChunkHandler {
 	 */
 	virtual void LoadCheck(size_t len = 0) const;
 
+	/**
+	 * Whether the chunk can be saved on another thread, at the same time as other chunks.
+	 * Only return true when Save() only reads game state, and does not use any state shared with the saving of other chunks.
+	 * @return True iff the chunk can be saved concurrently.
+	 */
+	virtual bool CanSaveConcurrently() const { return false; }
+
+	/**
+	 * Capture the state needed to save the chunk, so the chunk can be saved on the savegame thread while the game continues.
+	 * The returned function is called instead of Save(), and must only use the captured state.
+	 * @return Function saving the chunk from the captured state, or nullptr when the chunk has to be saved right away.
+	 */
+	virtual std::function<void()> Snapshot() const { return nullptr; }
+
 	std::string GetName() const
 	{
 		return std::string()
@@ -1315,6 +1334,8 @@ inline void SlSkipBytes(size_t length)
 }
 
 extern std::string _savegame_format;
+extern uint8_t _savegame_compression_workers;
+extern bool _savegame_blocks;
 extern bool _do_autosave;
 
 #endif /* SAVELOAD_H */
@@ -80,6 +80,13 @@ struct SaveFilter {
 	 */
 	virtual void Write(uint8_t *buf, size_t len) = 0;
 
+	/**
+	 * Notify the filter that the bytes of a chunk are written next.
+	 * Only the first filter in the chain is told about chunks, as only it knows where they are.
+	 * @param id The id of the chunk.
+	 */
+	virtual void StartChunk([[maybe_unused]] uint32_t id) {}
+
 	/**
 	 * Prepare everything to finish writing the savegame.
 	 */
@@ -100,4 +107,7 @@ template <typename T> std::shared_ptr<SaveFilter> CreateSaveFilter(std::shared_p
 	return std::make_shared<T>(chain, compression_level);
 }
 
+std::shared_ptr<SaveFilter> CreateBlockSaveFilter(std::shared_ptr<SaveFilter> chain, const std::string &format);
+std::shared_ptr<LoadFilter> CreateBlockLoadFilter(std::shared_ptr<LoadFilter> chain);
+
 #endif /* SAVELOAD_FILTER_H */
@@ -125,6 +125,9 @@ void AfterLoadStations()
 			Station *sta = Station::From(st);
 			for (const RoadStop *rs = sta->bus_stops; rs != nullptr; rs = rs->next) sta->bus_station.Add(rs->xy);
 			for (const RoadStop *rs = sta->truck_stops; rs != nullptr; rs = rs->next) sta->truck_station.Add(rs->xy);
+
+			/* Let the next rating update find out which cargo types actually need it. */
+			sta->rating_cargoes = ALL_CARGOTYPES;
 		}
 
 		StationUpdateCachedTriggers(st);
@@ -692,6 +695,8 @@ static const SaveLoad _station_desc[] = {
 struct STNNChunkHandler : ChunkHandler {
 	STNNChunkHandler() : ChunkHandler('STNN', CH_TABLE) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Save() const override
 	{
 		SlTableHeader(_station_desc);
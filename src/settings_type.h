@@ -167,6 +167,7 @@ struct GUISettings {
 	ZoomLevel sprite_zoom_min;               ///< maximum zoom level at which higher-resolution alternative sprites will be used (if available) instead of scaling a lower resolution sprite
 	uint32_t autosave_interval;              ///< how often should we do autosaves?
 	bool   threaded_saves;                   ///< should we do threaded saves?
+	bool   threaded_game_loop;               ///< should independent parts of the game loop be run on worker threads?
 	bool   keep_all_autosave;                ///< name the autosave in a different way
 	bool   autosave_on_exit;                 ///< save an autosave when you quit the game, but do not ask "Do you really want to quit?"
 	bool   autosave_on_network_disconnect;   ///< save an autosave when you get disconnected from a network game with an error?
@@ -458,6 +459,8 @@ struct YAPFSettings {
 	uint32_t rail_shorter_platform_per_tile_penalty; ///< penalty for shorter station platform than train (per tile)
 	uint32_t ship_curve45_penalty;                   ///< penalty for 45-deg curve for ships
 	uint32_t ship_curve90_penalty;                   ///< penalty for 90-deg curve for ships
+
+	bool operator==(const YAPFSettings &) const = default;
 };
 
 /** Settings related to all pathfinders. */
@@ -55,5 +55,6 @@ struct Ship final : public SpecializedVehicle<Ship, VEH_SHIP> {
 };
 
 bool IsShipDestinationTile(TileIndex tile, StationID station);
+void FindDeferredShipPaths();
 
 #endif /* SHIP_H */
@@ -484,6 +484,12 @@ static void ShipArrivesAt(const Vehicle *v, Station *st)
 }
 
 
+/** Minimum distance to its destination for a ship to keep its heading while its path is searched for. */
+static const uint SHIP_DEFERRED_PATH_MIN_DISTANCE = 32;
+
+/** Ships that kept their heading this tick and wait for the path search at the end of the tick, in the order they asked for it. */
+static std::vector<VehicleID> _deferred_ship_paths;
+
 /**
  * Runs the pathfinder to choose a track to continue along.
  *
@@ -518,6 +524,16 @@ static Track ChooseShipTrack(Ship *v, TileIndex tile, TrackBits tracks)
 			v->path.clear();
 		}
 
+		/* Far from its destination a ship keeps going straight on for a moment. Its path is searched
+		 * for at the end of the tick, together with the paths of the other ships that need one. */
+		if (IsDiagonalDirection(v->direction) && DistanceManhattan(tile, v->dest_tile) >= SHIP_DEFERRED_PATH_MIN_DISTANCE) {
+			const Track heading = DiagDirToDiagTrack(DirToDiagDir(v->direction));
+			if (HasBit(tracks, heading) && DirToDiagDir(v->direction) == DiagdirBetweenTiles(v->tile, tile)) {
+				if (_deferred_ship_paths.empty() || _deferred_ship_paths.back() != v->index) _deferred_ship_paths.push_back(v->index);
+				return heading;
+			}
+		}
+
 		track = YapfShipChooseTrack(v, tile, path_found, v->path);
 	}
 
@@ -866,6 +882,38 @@ static void ShipController(Ship *v)
 	}
 }
 
+/**
+ * Search the paths of the ships that kept their heading during this tick.
+ * The searches are spread over multiple threads. They are all done at the same point of the game loop
+ * and only read the game state, so every client comes to the same result.
+ */
+void FindDeferredShipPaths()
+{
+	if (_deferred_ship_paths.empty()) return;
+
+	std::vector<YapfShipPathRequest> requests;
+	for (VehicleID index : _deferred_ship_paths) {
+		const Ship *v = Ship::GetIfValid(index);
+		/* The ship might have been removed, entered a depot or an aqueduct, or got a new path in the meantime. */
+		if (v == nullptr || v->IsInDepot() || v->state == TRACK_BIT_WORMHOLE || v->dest_tile == 0 || !v->path.empty()) continue;
+
+		const DiagDirection exitdir = TrackdirToExitdir(v->GetVehicleTrackdir());
+		const TileIndex tile = TileAddByDiagDir(v->tile, exitdir);
+		if (!IsValidTile(tile) || GetAvailShipTracks(tile, exitdir) == TRACK_BIT_NONE) continue;
+
+		requests.push_back({ v, tile, true, {} });
+	}
+	_deferred_ship_paths.clear();
+
+	YapfShipChooseTracks(requests);
+
+	for (YapfShipPathRequest &request : requests) {
+		Ship *v = Ship::Get(request.v->index);
+		v->path = std::move(request.path);
+		v->HandlePathfindingResult(request.path_found);
+	}
+}
+
 bool Ship::Tick()
 {
 	PerformanceAccumulator framerate(PFE_GL_SHIPS);
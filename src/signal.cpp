@@ -15,17 +15,17 @@
 #include "viewport_func.h"
 #include "train.h"
 #include "company_base.h"
+#include "tilearea_type.h"
 
-#include "safeguards.h"
+#include <unordered_map>
 
+#include "safeguards.h"
 
-/** these are the maximums used for updating signal blocks */
-static const uint SIG_TBU_SIZE    =  64; ///< number of signals entering to block
-static const uint SIG_TBD_SIZE    = 256; ///< number of intersections - open nodes in current block
-static const uint SIG_GLOB_SIZE   = 128; ///< number of open blocks (block can be opened more times until detected)
-static const uint SIG_GLOB_UPDATE =  64; ///< how many items need to be in _globset to force update
 
-static_assert(SIG_GLOB_UPDATE <= SIG_GLOB_SIZE);
+/** how many items need to be in _globset to force update */
+static const uint SIG_GLOB_UPDATE = 64;
+/** Number of tile sides in searched signal blocks to remember before forgetting all of them. */
+static const size_t MAX_SIGNAL_SEGMENT_SIDES = 1 << 22;
 
 /** incidating trackbits with given enterdir */
 static const TrackBits _enterdir_to_trackbits[DIAGDIR_END] = {
@@ -44,68 +44,43 @@ static const TrackdirBits _enterdir_to_trackdirbits[DIAGDIR_END] = {
 };
 
 /**
- * Set containing 'items' items of 'tile and Tdir'
+ * Set of 'tile and Tdir' items, growing as needed
  * No tree structure is used because it would cause
  * slowdowns in most usual cases
  */
-template <typename Tdir, uint items>
+template <typename Tdir>
 struct SmallSet {
 private:
-	uint n;           // actual number of units
-	bool overflowed;  // did we try to overflow the set?
-	const char *name; // name, used for debugging purposes...
-
 	/** Element of set */
 	struct SSdata {
 		TileIndex tile;
 		Tdir dir;
-	} data[items];
+	};
+	std::vector<SSdata> data;
 
 public:
-	/** Constructor - just set default values and 'name' */
-	SmallSet(const char *name) : n(0), overflowed(false), name(name) { }
-
 	/** Reset variables to default values */
 	void Reset()
 	{
-		this->n = 0;
-		this->overflowed = false;
-	}
-
-	/**
-	 * Returns value of 'overflowed'
-	 * @return did we try to overflow the set?
-	 */
-	bool Overflowed()
-	{
-		return this->overflowed;
+		this->data.clear();
 	}
 
 	/**
 	 * Checks for empty set
 	 * @return is the set empty?
 	 */
-	bool IsEmpty()
-	{
-		return this->n == 0;
-	}
-
-	/**
-	 * Checks for full set
-	 * @return is the set full?
-	 */
-	bool IsFull()
+	bool IsEmpty() const
 	{
-		return this->n == lengthof(data);
+		return this->data.empty();
 	}
 
 	/**
 	 * Reads the number of items
 	 * @return current number of items
 	 */
-	uint Items()
+	uint Items() const
 	{
-		return this->n;
+		return static_cast<uint>(this->data.size());
 	}
 
 
@@ -117,9 +92,10 @@ public:
 	 */
 	bool Remove(TileIndex tile, Tdir dir)
 	{
-		for (uint i = 0; i < this->n; i++) {
-			if (this->data[i].tile == tile && this->data[i].dir == dir) {
-				this->data[i] = this->data[--this->n];
+		for (SSdata &item : this->data) {
+			if (item.tile == tile && item.dir == dir) {
+				item = this->data.back();
+				this->data.pop_back();
 				return true;
 			}
 		}
@@ -133,35 +109,23 @@ public:
 	 * @param dir and dir to find
 	 * @return true iff the tile & dir element was found
 	 */
-	bool IsIn(TileIndex tile, Tdir dir)
+	bool IsIn(TileIndex tile, Tdir dir) const
 	{
-		for (uint i = 0; i < this->n; i++) {
-			if (this->data[i].tile == tile && this->data[i].dir == dir) return true;
+		for (const SSdata &item : this->data) {
+			if (item.tile == tile && item.dir == dir) return true;
 		}
 
 		return false;
 	}
 
 	/**
-	 * Adds tile & dir into the set, checks for full set
-	 * Sets the 'overflowed' flag if the set was full
+	 * Adds tile & dir into the set
 	 * @param tile tile
 	 * @param dir and dir to add
-	 * @return true iff the item could be added (set wasn't full)
 	 */
-	bool Add(TileIndex tile, Tdir dir)
+	void Add(TileIndex tile, Tdir dir)
 	{
-		if (this->IsFull()) {
-			overflowed = true;
-			Debug(misc, 0, "SignalSegment too complex. Set {} is full (maximum {})", name, items);
-			return false; // set is full
-		}
-
-		this->data[this->n].tile = tile;
-		this->data[this->n].dir = dir;
-		this->n++;
-
-		return true;
+		this->data.push_back({ tile, dir });
 	}
 
 	/**
@@ -172,19 +136,60 @@ public:
 	 */
 	bool Get(TileIndex *tile, Tdir *dir)
 	{
-		if (this->n == 0) return false;
+		if (this->data.empty()) return false;
 
-		this->n--;
-		*tile = this->data[this->n].tile;
-		*dir = this->data[this->n].dir;
+		*tile = this->data.back().tile;
+		*dir = this->data.back().dir;
+		this->data.pop_back();
 
 		return true;
 	}
 };
 
-static SmallSet<Trackdir, SIG_TBU_SIZE> _tbuset("_tbuset");         ///< set of signals that will be updated
-static SmallSet<DiagDirection, SIG_TBD_SIZE> _tbdset("_tbdset");    ///< set of open nodes in current signal block
-static SmallSet<DiagDirection, SIG_GLOB_SIZE> _globset("_globset"); ///< set of places to be updated in following runs
+static SmallSet<Trackdir> _tbuset;         ///< set of signals that will be updated
+static SmallSet<DiagDirection> _tbdset;    ///< set of open nodes in current signal block
+static SmallSet<DiagDirection> _globset;   ///< set of places to be updated in following runs
+
+/**
+ * Everything about a signal block that only changes when the tracks or signals change, as found by
+ * exploring it. Updating the signals around a known block then only needs to look for trains on its
+ * tiles and at the state of its pre-signal exits, instead of following all its tracks again.
+ */
+struct SignalSegment {
+	std::vector<std::pair<TileIndex, TrackBits>> train_tiles; ///< Tiles to look for trains on, with the tracks to check or #INVALID_TRACK_BIT for any train outside a depot.
+	std::vector<std::pair<TileIndex, Trackdir>> exits;        ///< Pre-signal exits leading out of the block, in the order they were found.
+	std::vector<std::pair<TileIndex, Trackdir>> signals;      ///< Conventional signals leading into the block, in the order they were found.
+	std::vector<std::pair<TileIndex, DiagDirection>> sides;   ///< Tile sides to remove from #_globset, in the order they were passed.
+	TileArea area;                                            ///< Area containing all tiles the search looked at.
+	bool pbs = false;                                         ///< Whether a path signal was found.
+
+	bool operator==(const SignalSegment &other) const = default;
+};
+
+/** Places an exploration of a signal block started from; the same start always leads to the same block. */
+struct SignalSegmentKey {
+	TileIndex tile[2];      ///< Tiles the exploration started from, INVALID_TILE if unused.
+	DiagDirection dir[2];   ///< Directions the tiles were entered from.
+	Owner owner;            ///< Owner whose signals were updated.
+
+	bool operator==(const SignalSegmentKey &other) const = default;
+};
+
+template <>
+struct std::hash<SignalSegmentKey> {
+	size_t operator()(const SignalSegmentKey &key) const
+	{
+		size_t hash = key.tile[0].base();
+		hash = hash * 31 + key.tile[1].base();
+		hash = hash * 31 + key.dir[0];
+		hash = hash * 31 + key.dir[1];
+		hash = hash * 31 + key.owner;
+		return hash;
+	}
+};
+
+static std::unordered_map<SignalSegmentKey, SignalSegment> _signal_segments; ///< Signal blocks searched since the tracks last changed.
+static size_t _signal_segment_sides = 0; ///< Number of tile sides in #_signal_segments.
 
 
 /** Check whether there is a train on rail, not in a depot */
@@ -198,46 +203,25 @@ static Vehicle *TrainOnTileEnum(Vehicle *v, void *)
 
 /**
  * Perform some operations before adding data into Todo set
- * The new and reverse direction is removed from _globset, because we are sure
- * it doesn't need to be checked again
+ * The new and reverse direction are to be removed from _globset, because we are sure
+ * they don't need to be checked again
  * Also, remove reverse direction from _tbdset
  * This is the 'core' part so the graph searching won't enter any tile twice
  *
+ * @param segment segment the sides to remove from _globset are recorded in
  * @param t1 tile we are entering
  * @param d1 direction (tile side) we are entering
  * @param t2 tile we are leaving
  * @param d2 direction (tile side) we are leaving
- * @return false iff reverse direction was in Todo set
  */
-static inline bool CheckAddToTodoSet(TileIndex t1, DiagDirection d1, TileIndex t2, DiagDirection d2)
+static inline void MaybeAddToTodoSet(SignalSegment &segment, TileIndex t1, DiagDirection d1, TileIndex t2, DiagDirection d2)
 {
-	_globset.Remove(t1, d1); // it can be in Global but not in Todo
-	_globset.Remove(t2, d2); // remove in all cases
+	segment.sides.emplace_back(t1, d1); // it can be in Global but not in Todo
+	segment.sides.emplace_back(t2, d2); // remove in all cases
 
 	assert(!_tbdset.IsIn(t1, d1)); // it really shouldn't be there already
 
-	return !_tbdset.Remove(t2, d2);
-}
-
-
-/**
- * Perform some operations before adding data into Todo set
- * The new and reverse direction is removed from Global set, because we are sure
- * it doesn't need to be checked again
- * Also, remove reverse direction from Todo set
- * This is the 'core' part so the graph searching won't enter any tile twice
- *
- * @param t1 tile we are entering
- * @param d1 direction (tile side) we are entering
- * @param t2 tile we are leaving
- * @param d2 direction (tile side) we are leaving
- * @return false iff the Todo buffer would be overrun
- */
-static inline bool MaybeAddToTodoSet(TileIndex t1, DiagDirection d1, TileIndex t2, DiagDirection d2)
-{
-	if (!CheckAddToTodoSet(t1, d1, t2, d2)) return true;
-
-	return _tbdset.Add(t1, d1);
+	if (!_tbdset.Remove(t2, d2)) _tbdset.Add(t1, d1);
 }
 
 
@@ -249,8 +233,7 @@ enum SigFlags {
 	SF_EXIT2  = 1 << 2, ///< two or more exits found
 	SF_GREEN  = 1 << 3, ///< green exitsignal found
 	SF_GREEN2 = 1 << 4, ///< two or more green exits found
-	SF_FULL   = 1 << 5, ///< some of buffers was full, do not continue
-	SF_PBS    = 1 << 6, ///< pbs signal found
+	SF_PBS    = 1 << 5, ///< pbs signal found
 };
 
 DECLARE_ENUM_AS_BIT_SET(SigFlags)
@@ -260,16 +243,16 @@ DECLARE_ENUM_AS_BIT_SET(SigFlags)
  * Search signal block
  *
  * @param owner owner whose signals we are updating
- * @return SigFlags
+ * @param segment segment to record the found block in
  */
-static SigFlags ExploreSegment(Owner owner)
+static void ExploreSegment(Owner owner, SignalSegment &segment)
 {
-	SigFlags flags = SF_NONE;
-
 	TileIndex tile = INVALID_TILE; // Stop GCC from complaining about a possibly uninitialized variable (issue #8280).
 	DiagDirection enterdir = INVALID_DIAGDIR;
 
 	while (_tbdset.Get(&tile, &enterdir)) { // tile and enterdir are initialized here, unless I'm mistaken.
+		segment.area.Add(tile);
+
 		TileIndex oldtile = tile; // tile we are leaving
 		DiagDirection exitdir = enterdir == INVALID_DIAGDIR ? INVALID_DIAGDIR : ReverseDiagDir(enterdir); // expected new exit direction (for straight line)
 
@@ -279,13 +262,13 @@ static SigFlags ExploreSegment(Owner owner)
 
 				if (IsRailDepot(tile)) {
 					if (enterdir == INVALID_DIAGDIR) { // from 'inside' - train just entered or left the depot
-						if (!(flags & SF_TRAIN) && HasVehicleOnPos(tile, nullptr, &TrainOnTileEnum)) flags |= SF_TRAIN;
+						segment.train_tiles.emplace_back(tile, INVALID_TRACK_BIT);
 						exitdir = GetRailDepotDirection(tile);
 						tile += TileOffsByDiagDir(exitdir);
 						enterdir = ReverseDiagDir(exitdir);
 						break;
 					} else if (enterdir == GetRailDepotDirection(tile)) { // entered a depot
-						if (!(flags & SF_TRAIN) && HasVehicleOnPos(tile, nullptr, &TrainOnTileEnum)) flags |= SF_TRAIN;
+						segment.train_tiles.emplace_back(tile, INVALID_TRACK_BIT);
 						continue;
 					} else {
 						continue;
@@ -298,11 +281,11 @@ static SigFlags ExploreSegment(Owner owner)
 
 				if (tracks == TRACK_BIT_HORZ || tracks == TRACK_BIT_VERT) { // there is exactly one incidating track, no need to check
 					tracks = tracks_masked;
-					/* If no train detected yet, and there is not no train -> there is a train -> set the flag */
-					if (!(flags & SF_TRAIN) && EnsureNoTrainOnTrackBits(tile, tracks).Failed()) flags |= SF_TRAIN;
+					/* Only a train on the incidating track counts */
+					segment.train_tiles.emplace_back(tile, tracks);
 				} else {
 					if (tracks_masked == TRACK_BIT_NONE) continue; // no incidating track
-					if (!(flags & SF_TRAIN) && HasVehicleOnPos(tile, nullptr, &TrainOnTileEnum)) flags |= SF_TRAIN;
+					segment.train_tiles.emplace_back(tile, INVALID_TRACK_BIT);
 				}
 
 				if (HasSignals(tile)) { // there is exactly one track - not zero, because there is exit from this tile
@@ -316,22 +299,15 @@ static SigFlags ExploreSegment(Owner owner)
 						 * (if it is a presignal EXIT and it changes, it will be added to 'to-be-done' set later) */
 						if (HasSignalOnTrackdir(tile, reversedir)) {
 							if (IsPbsSignal(sig)) {
-								flags |= SF_PBS;
-							} else if (!_tbuset.Add(tile, reversedir)) {
-								return flags | SF_FULL;
-							}
-						}
-						if (HasSignalOnTrackdir(tile, trackdir) && !IsOnewaySignal(tile, track)) flags |= SF_PBS;
-
-						/* if it is a presignal EXIT in OUR direction and we haven't found 2 green exits yes, do special check */
-						if (!(flags & SF_GREEN2) && IsPresignalExit(tile, track) && HasSignalOnTrackdir(tile, trackdir)) { // found presignal exit
-							if (flags & SF_EXIT) flags |= SF_EXIT2; // found two (or more) exits
-							flags |= SF_EXIT; // found at least one exit - allow for compiler optimizations
-							if (GetSignalStateByTrackdir(tile, trackdir) == SIGNAL_STATE_GREEN) { // found green presignal exit
-								if (flags & SF_GREEN) flags |= SF_GREEN2;
-								flags |= SF_GREEN;
+								segment.pbs = true;
+							} else {
+								segment.signals.emplace_back(tile, reversedir);
 							}
 						}
+						if (HasSignalOnTrackdir(tile, trackdir) && !IsOnewaySignal(tile, track)) segment.pbs = true;
+
+						/* if it is a presignal EXIT in OUR direction, its state has to be checked */
+						if (IsPresignalExit(tile, track) && HasSignalOnTrackdir(tile, trackdir)) segment.exits.emplace_back(tile, trackdir);
 
 						continue;
 					}
@@ -341,7 +317,7 @@ static SigFlags ExploreSegment(Owner owner)
 					if (dir != enterdir && (tracks & _enterdir_to_trackbits[dir])) { // any track incidating?
 						TileIndex newtile = tile + TileOffsByDiagDir(dir);  // new tile to check
 						DiagDirection newdir = ReverseDiagDir(dir); // direction we are entering from
-						if (!MaybeAddToTodoSet(newtile, newdir, tile, dir)) return flags | SF_FULL;
+						MaybeAddToTodoSet(segment, newtile, newdir, tile, dir);
 					}
 				}
 
@@ -354,7 +330,7 @@ static SigFlags ExploreSegment(Owner owner)
 				if (DiagDirToAxis(enterdir) != GetRailStationAxis(tile)) continue; // different axis
 				if (IsStationTileBlocked(tile)) continue; // 'eye-candy' station tile
 
-				if (!(flags & SF_TRAIN) && HasVehicleOnPos(tile, nullptr, &TrainOnTileEnum)) flags |= SF_TRAIN;
+				segment.train_tiles.emplace_back(tile, INVALID_TRACK_BIT);
 				tile += TileOffsByDiagDir(exitdir);
 				break;
 
@@ -363,7 +339,7 @@ static SigFlags ExploreSegment(Owner owner)
 				if (GetTileOwner(tile) != owner) continue;
 				if (DiagDirToAxis(enterdir) == GetCrossingRoadAxis(tile)) continue; // different axis
 
-				if (!(flags & SF_TRAIN) && HasVehicleOnPos(tile, nullptr, &TrainOnTileEnum)) flags |= SF_TRAIN;
+				segment.train_tiles.emplace_back(tile, INVALID_TRACK_BIT);
 				tile += TileOffsByDiagDir(exitdir);
 				break;
 
@@ -373,13 +349,13 @@ static SigFlags ExploreSegment(Owner owner)
 				DiagDirection dir = GetTunnelBridgeDirection(tile);
 
 				if (enterdir == INVALID_DIAGDIR) { // incoming from the wormhole
-					if (!(flags & SF_TRAIN) && HasVehicleOnPos(tile, nullptr, &TrainOnTileEnum)) flags |= SF_TRAIN;
+					segment.train_tiles.emplace_back(tile, INVALID_TRACK_BIT);
 					enterdir = dir;
 					exitdir = ReverseDiagDir(dir);
 					tile += TileOffsByDiagDir(exitdir); // just skip to next tile
 				} else { // NOT incoming from the wormhole!
 					if (ReverseDiagDir(enterdir) != dir) continue;
-					if (!(flags & SF_TRAIN) && HasVehicleOnPos(tile, nullptr, &TrainOnTileEnum)) flags |= SF_TRAIN;
+					segment.train_tiles.emplace_back(tile, INVALID_TRACK_BIT);
 					tile = GetOtherTunnelBridgeEnd(tile); // just skip to exit tile
 					enterdir = INVALID_DIAGDIR;
 					exitdir = INVALID_DIAGDIR;
@@ -391,8 +367,47 @@ static SigFlags ExploreSegment(Owner owner)
 				continue; // continue the while() loop
 		}
 
-		if (!MaybeAddToTodoSet(tile, enterdir, oldtile, exitdir)) return flags | SF_FULL;
+		MaybeAddToTodoSet(segment, tile, enterdir, oldtile, exitdir);
 	}
+}
+
+
+/**
+ * Check the state of a searched signal block
+ * Fills _tbuset with the signals to update and removes the passed tile sides from _globset
+ *
+ * @param segment the block
+ * @return SigFlags
+ */
+static SigFlags CheckSegment(const SignalSegment &segment)
+{
+	for (const auto &[tile, dir] : segment.sides) {
+		if (_globset.IsEmpty()) break;
+		_globset.Remove(tile, dir);
+	}
+
+	SigFlags flags = segment.pbs ? SF_PBS : SF_NONE;
+
+	for (const auto &[tile, tracks] : segment.train_tiles) {
+		if (tracks == INVALID_TRACK_BIT ? HasVehicleOnPos(tile, nullptr, &TrainOnTileEnum) : EnsureNoTrainOnTrackBits(tile, tracks).Failed()) {
+			flags |= SF_TRAIN;
+			break;
+		}
+	}
+
+	for (const auto &[tile, trackdir] : segment.exits) {
+		/* we haven't found 2 green exits yet */
+		if (flags & SF_GREEN2) break;
+
+		if (flags & SF_EXIT) flags |= SF_EXIT2; // found two (or more) exits
+		flags |= SF_EXIT; // found at least one exit - allow for compiler optimizations
+		if (GetSignalStateByTrackdir(tile, trackdir) == SIGNAL_STATE_GREEN) { // found green presignal exit
+			if (flags & SF_GREEN) flags |= SF_GREEN2;
+			flags |= SF_GREEN;
+		}
+	}
+
+	for (const auto &[tile, trackdir] : segment.signals) _tbuset.Add(tile, trackdir);
 
 	return flags;
 }
@@ -449,12 +464,59 @@ static void UpdateSignalsAroundSegment(SigFlags flags)
 }
 
 
-/** Reset all sets after one set overflowed */
-static inline void ResetSets()
+/**
+ * Get the signal block the open nodes in _tbdset are part of, searching it when it is not known yet
+ *
+ * @param key the places the search starts from
+ * @return the block
+ */
+static const SignalSegment &GetSignalSegment(const SignalSegmentKey &key)
+{
+	auto it = _signal_segments.find(key);
+	if (it != _signal_segments.end()) {
+		_tbdset.Reset();
+
+		if (_debug_desync_level >= 2) {
+			SignalSegment segment;
+			for (uint i = 0; i < lengthof(key.tile) && key.tile[i] != INVALID_TILE; i++) _tbdset.Add(key.tile[i], key.dir[i]);
+			ExploreSegment(key.owner, segment);
+			if (segment != it->second) Debug(desync, 2, "warning: signal block at {} does not match the searched block", key.tile[0]);
+		}
+		return it->second;
+	}
+
+	if (_signal_segment_sides >= MAX_SIGNAL_SEGMENT_SIDES) InvalidateSignalSegments();
+
+	SignalSegment &segment = _signal_segments[key];
+	ExploreSegment(key.owner, segment);
+	_signal_segment_sides += segment.sides.size();
+	return segment;
+}
+
+
+/** Forget all searched signal blocks, as the tracks or signals in them might have changed */
+void InvalidateSignalSegments()
+{
+	_signal_segments.clear();
+	_signal_segment_sides = 0;
+}
+
+/**
+ * Forget the searched signal blocks that looked at a tile, as the tracks on it changed
+ * A block only reaches other tiles via the tracks of the tiles it looked at, so other blocks stay the same.
+ *
+ * @param tile the changed tile
+ */
+void InvalidateSignalSegments(TileIndex tile)
 {
-	_tbuset.Reset();
-	_tbdset.Reset();
-	_globset.Reset();
+	for (auto it = _signal_segments.begin(); it != _signal_segments.end();) {
+		if (it->second.area.Contains(tile)) {
+			_signal_segment_sides -= it->second.sides.size();
+			it = _signal_segments.erase(it);
+		} else {
+			++it;
+		}
+	}
 }
 
 
@@ -479,6 +541,14 @@ static SigSegState UpdateSignalsInBuffer(Owner owner)
 		assert(_tbuset.IsEmpty());
 		assert(_tbdset.IsEmpty());
 
+		SignalSegmentKey key = { { INVALID_TILE, INVALID_TILE }, { INVALID_DIAGDIR, INVALID_DIAGDIR }, owner };
+		auto add_start = [&key](TileIndex start_tile, DiagDirection start_dir) {
+			uint i = key.tile[0] == INVALID_TILE ? 0 : 1;
+			key.tile[i] = start_tile;
+			key.dir[i] = start_dir;
+			_tbdset.Add(start_tile, start_dir);
+		};
+
 		/* After updating signal, data stored are always MP_RAILWAY with signals.
 		 * Other situations happen when data are from outside functions -
 		 * modification of railbits (including both rail building and removal),
@@ -489,15 +559,15 @@ static SigSegState UpdateSignalsInBuffer(Owner owner)
 				/* 'optimization assert' - do not try to update signals when it is not needed */
 				assert(GetTunnelBridgeTransportType(tile) == TRANSPORT_RAIL);
 				assert(dir == INVALID_DIAGDIR || dir == ReverseDiagDir(GetTunnelBridgeDirection(tile)));
-				_tbdset.Add(tile, INVALID_DIAGDIR);  // we can safely start from wormhole centre
-				_tbdset.Add(GetOtherTunnelBridgeEnd(tile), INVALID_DIAGDIR);
+				add_start(tile, INVALID_DIAGDIR);  // we can safely start from wormhole centre
+				add_start(GetOtherTunnelBridgeEnd(tile), INVALID_DIAGDIR);
 				break;
 
 			case MP_RAILWAY:
 				if (IsRailDepot(tile)) {
 					/* 'optimization assert' do not try to update signals in other cases */
 					assert(dir == INVALID_DIAGDIR || dir == GetRailDepotDirection(tile));
-					_tbdset.Add(tile, INVALID_DIAGDIR); // start from depot inside
+					add_start(tile, INVALID_DIAGDIR); // start from depot inside
 					break;
 				}
 				[[fallthrough]];
@@ -506,8 +576,8 @@ static SigSegState UpdateSignalsInBuffer(Owner owner)
 			case MP_ROAD:
 				if ((TrackStatusToTrackBits(GetTileTrackStatus(tile, TRANSPORT_RAIL, 0)) & _enterdir_to_trackbits[dir]) != TRACK_BIT_NONE) {
 					/* only add to set when there is some 'interesting' track */
-					_tbdset.Add(tile, dir);
-					_tbdset.Add(tile + TileOffsByDiagDir(dir), ReverseDiagDir(dir));
+					add_start(tile, dir);
+					add_start(tile + TileOffsByDiagDir(dir), ReverseDiagDir(dir));
 					break;
 				}
 				[[fallthrough]];
@@ -517,34 +587,27 @@ static SigSegState UpdateSignalsInBuffer(Owner owner)
 				tile = tile + TileOffsByDiagDir(dir);
 				dir = ReverseDiagDir(dir);
 				if ((TrackStatusToTrackBits(GetTileTrackStatus(tile, TRANSPORT_RAIL, 0)) & _enterdir_to_trackbits[dir]) != TRACK_BIT_NONE) {
-					_tbdset.Add(tile, dir);
+					add_start(tile, dir);
 					break;
 				}
 				/* happens when removing a rail that wasn't connected at one or both sides */
 				continue; // continue the while() loop
 		}
 
-		assert(!_tbdset.Overflowed()); // it really shouldn't overflow by these one or two items
 		assert(!_tbdset.IsEmpty()); // it wouldn't hurt anyone, but shouldn't happen too
 
-		SigFlags flags = ExploreSegment(owner);
+		SigFlags flags = CheckSegment(GetSignalSegment(key));
 
 		if (first) {
 			first = false;
 			/* SIGSEG_FREE is set by default */
 			if (flags & SF_PBS) {
 				state = SIGSEG_PBS;
-			} else if ((flags & SF_TRAIN) || ((flags & SF_EXIT) && !(flags & SF_GREEN)) || (flags & SF_FULL)) {
+			} else if ((flags & SF_TRAIN) || ((flags & SF_EXIT) && !(flags & SF_GREEN))) {
 				state = SIGSEG_FULL;
 			}
 		}
 
-		/* do not do anything when some buffer was full */
-		if (flags & SF_FULL) {
-			ResetSets(); // free all sets
-			break;
-		}
-
 		UpdateSignalsAroundSegment(flags);
 	}
 
@@ -569,13 +632,13 @@ void UpdateSignalsInBuffer()
 
 
 /**
- * Add track to signal update buffer
+ * Add track to signal update buffer, without forgetting the searched signal blocks
  *
  * @param tile tile where we start
  * @param track track at which ends we will update signals
  * @param owner owner whose signals we will update
  */
-void AddTrackToSignalBuffer(TileIndex tile, Track track, Owner owner)
+static void AddTrackToBuffer(TileIndex tile, Track track, Owner owner)
 {
 	static const DiagDirection _search_dir_1[] = {
 		DIAGDIR_NE, DIAGDIR_SE, DIAGDIR_NE, DIAGDIR_SE, DIAGDIR_SW, DIAGDIR_SE
@@ -600,8 +663,25 @@ void AddTrackToSignalBuffer(TileIndex tile, Track track, Owner owner)
 }
 
 
+/**
+ * Add track to signal update buffer
+ * The track or its signals changed, so the searched signal blocks are forgotten
+ *
+ * @param tile tile where we start
+ * @param track track at which ends we will update signals
+ * @param owner owner whose signals we will update
+ */
+void AddTrackToSignalBuffer(TileIndex tile, Track track, Owner owner)
+{
+	InvalidateSignalSegments();
+	InvalidateTrainFreeRuns();
+	AddTrackToBuffer(tile, track, owner);
+}
+
+
 /**
  * Add side of tile to signal update buffer
+ * The tracks at the side changed, so the searched signal blocks are forgotten
  *
  * @param tile tile where we start
  * @param side side of tile
@@ -609,6 +689,9 @@ void AddTrackToSignalBuffer(TileIndex tile, Track track, Owner owner)
  */
 void AddSideToSignalBuffer(TileIndex tile, DiagDirection side, Owner owner)
 {
+	InvalidateSignalSegments();
+	InvalidateTrainFreeRuns();
+
 	/* do not allow signal updates for two companies in one run */
 	assert(_globset.IsEmpty() || owner == _last_owner);
 
@@ -655,6 +738,6 @@ void SetSignalsOnBothDir(TileIndex tile, Track track, Owner owner)
 {
 	assert(_globset.IsEmpty());
 
-	AddTrackToSignalBuffer(tile, track, owner);
+	AddTrackToBuffer(tile, track, owner);
 	UpdateSignalsInBuffer(owner);
 }
@@ -103,9 +103,10 @@ Station::~Station()
 		if (lg == nullptr) continue;
 
 		for (NodeID node = 0; node < lg->Size(); ++node) {
-			Station *st = Station::Get((*lg)[node].station);
+			const LinkGraph::BaseNode &n = std::as_const(*lg)[node];
+			Station *st = Station::Get(n.station);
 			st->goods[c].flows.erase(this->index);
-			if ((*lg)[node].HasEdgeTo(this->goods[c].node) && (*lg)[node][this->goods[c].node].LastUpdate() != EconomyTime::INVALID_DATE) {
+			if (n.HasEdgeTo(this->goods[c].node) && n[this->goods[c].node].LastUpdate() != EconomyTime::INVALID_DATE) {
 				st->goods[c].flows.DeleteFlows(this->index);
 				RerouteCargo(st, c, this->index, st->index);
 			}
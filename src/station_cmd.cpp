@@ -2094,6 +2094,7 @@ CommandCost CmdBuildRoadStop(DoCommandFlag flags, TileIndex tile, uint8_t width,
 			UpdateCompanyRoadInfrastructure(road_rt, road_owner, ROAD_STOP_TRACKBIT_FACTOR);
 			UpdateCompanyRoadInfrastructure(tram_rt, tram_owner, ROAD_STOP_TRACKBIT_FACTOR);
 			Company::Get(st->owner)->infrastructure.station++;
+			YapfNotifyRoadLayoutChange(cur_tile);
 
 			SetCustomRoadStopSpecIndex(cur_tile, specindex);
 			if (roadstopspec != nullptr) {
@@ -2359,6 +2360,7 @@ static CommandCost RemoveGenericRoadStop(DoCommandFlag flags, const TileArea &ro
 		if ((flags & DC_EXEC) && (road_type[RTT_ROAD] != INVALID_ROADTYPE || road_type[RTT_TRAM] != INVALID_ROADTYPE)) {
 			MakeRoadNormal(cur_tile, road_bits, road_type[RTT_ROAD], road_type[RTT_TRAM], ClosestTownFromTile(cur_tile, UINT_MAX)->index,
 					road_owner[RTT_ROAD], road_owner[RTT_TRAM]);
+			YapfNotifyRoadLayoutChange(cur_tile);
 
 			/* Update company infrastructure counts. */
 			int count = CountBits(road_bits);
@@ -3834,8 +3836,13 @@ static void UpdateStationRating(Station *st)
 	byte_inc_sat(&st->time_since_load);
 	byte_inc_sat(&st->time_since_unload);
 
-	for (const CargoSpec *cs : CargoSpec::Iterate()) {
-		GoodsEntry *ge = &st->goods[cs->Index()];
+	/* Only look at cargo types of which the rating might change; that is in the same order
+	 * as iterating all cargo specs, so the random numbers are drawn in the same order too. */
+	for (CargoID c : SetCargoBitIterator(st->rating_cargoes)) {
+		const CargoSpec *cs = CargoSpec::Get(c);
+		if (!cs->IsValid()) continue;
+
+		GoodsEntry *ge = &st->goods[c];
 		/* Slowly increase the rating back to its original level in the case we
 		 *  didn't deliver cargo yet to this station. This happens when a bribe
 		 *  failed while you didn't moved that cargo yet to a station. */
@@ -3978,6 +3985,12 @@ static void UpdateStationRating(Station *st)
 		}
 	}
 
+	/* Forget about cargo types that are not moved and have recovered their rating. */
+	for (CargoID c : SetCargoBitIterator(st->rating_cargoes)) {
+		const GoodsEntry &ge = st->goods[c];
+		if (!CargoSpec::Get(c)->IsValid() || (!ge.HasRating() && ge.rating >= INITIAL_STATION_RATING)) ClrBit(st->rating_cargoes, c);
+	}
+
 	StationID index = st->index;
 	if (waiting_changed) {
 		SetWindowDirty(WC_STATION_VIEW, index); // update whole window
@@ -4027,7 +4040,7 @@ void DeleteStaleLinks(Station *from)
 		if (lg == nullptr) continue;
 		std::vector<NodeID> to_remove{};
 		for (Edge &edge : (*lg)[ge.node].edges) {
-			Station *to = Station::Get((*lg)[edge.dest_node].station);
+			Station *to = Station::Get(std::as_const(*lg)[edge.dest_node].station);
 			assert(to->goods[c].node == edge.dest_node);
 			assert(TimerGameEconomy::date >= edge.LastUpdate());
 			auto timeout = TimerGameEconomy::Date(LinkGraph::MIN_TIMEOUT_DISTANCE + (DistanceManhattan(from->xy, to->xy) >> 3));
@@ -4239,6 +4252,7 @@ void ModifyStationRatingAround(TileIndex tile, Owner owner, int amount, uint rad
 					ge.rating = ClampTo<uint8_t>(ge.rating + amount);
 				}
 			}
+			st->rating_cargoes = ALL_CARGOTYPES;
 		}
 	});
 }
@@ -4277,6 +4291,7 @@ static uint UpdateStationWaiting(Station *st, CargoID type, uint amount, SourceT
 	if (!ge.HasRating()) {
 		InvalidateWindowData(WC_STATION_LIST, st->owner);
 		SetBit(ge.status, GoodsEntry::GES_RATING);
+		SetBit(st->rating_cargoes, type);
 	}
 
 	TriggerStationRandomisation(st, st->xy, SRT_NEW_CARGO, type);
@@ -19,6 +19,8 @@
 #include "core/backup_type.hpp"
 #include "terraform_cmd.h"
 #include "landscape_cmd.h"
+#include "road_map.h"
+#include "pathfinder/yapf/yapf_cache.h"
 
 #include "table/strings.h"
 
@@ -309,6 +311,11 @@ std::tuple<CommandCost, Money, TileIndex> CmdTerraformLand(DoCommandFlag flags,
 			SetTileHeight(t, (uint)height);
 		}
 
+		/* Slopes of roads influence road vehicle paths. */
+		for (const auto &t : ts.dirty_tiles) {
+			if (MayHaveRoad(t)) YapfNotifyRoadLayoutChange(t);
+		}
+
 		if (c != nullptr) c->terraform_limit -= (uint32_t)ts.tile_to_new_height.size() << 16;
 	}
 	return { total_cost, 0, total_cost.Succeeded() ? tile : INVALID_TILE };
@@ -0,0 +1,125 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file test_savegame_blocks.cpp Tests for writing and reading savegames as independently compressed blocks. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../saveload/saveload_filter.h"
+
+/** Save filter writing into memory. */
+struct TestMemorySaveFilter : SaveFilter {
+	std::vector<uint8_t> &buffer; ///< The memory to write to.
+
+	TestMemorySaveFilter(std::vector<uint8_t> &buffer) : SaveFilter(nullptr), buffer(buffer) {}
+
+	void Write(uint8_t *buf, size_t size) override
+	{
+		this->buffer.insert(this->buffer.end(), buf, buf + size);
+	}
+
+	void Finish() override {}
+};
+
+/** Load filter reading from memory. */
+struct TestMemoryLoadFilter : LoadFilter {
+	const std::vector<uint8_t> &buffer; ///< The memory to read from.
+	size_t pos = 0;                     ///< The position to read from next.
+
+	TestMemoryLoadFilter(const std::vector<uint8_t> &buffer) : LoadFilter(nullptr), buffer(buffer) {}
+
+	size_t Read(uint8_t *buf, size_t size) override
+	{
+		size = std::min(size, this->buffer.size() - this->pos);
+		std::copy_n(this->buffer.data() + this->pos, size, buf);
+		this->pos += size;
+		return size;
+	}
+};
+
+/**
+ * Create data that is somewhat compressible, like a savegame.
+ * @param size The number of bytes.
+ * @return The data.
+ */
+static std::vector<uint8_t> CreateTestData(size_t size)
+{
+	std::vector<uint8_t> data(size);
+	uint32_t state = 12345;
+	for (size_t i = 0; i < size; i++) {
+		state = state * 1103515245 + 12345;
+		data[i] = (i % 7 == 0) ? static_cast<uint8_t>(state >> 24) : static_cast<uint8_t>(i / 1024);
+	}
+	return data;
+}
+
+/**
+ * Write data as blocks and read it back, in pieces of awkward sizes.
+ * @param format The format to compress the blocks with.
+ * @param size The number of bytes to write.
+ */
+static void CheckBlockRoundTrip(const std::string &format, size_t size)
+{
+	const std::vector<uint8_t> data = CreateTestData(size);
+
+	std::vector<uint8_t> saved;
+	{
+		std::shared_ptr<SaveFilter> writer = CreateBlockSaveFilter(std::make_shared<TestMemorySaveFilter>(saved), format);
+		size_t pos = 0;
+		uint32_t chunk = 0;
+		while (pos < data.size()) {
+			size_t piece = std::min<size_t>(data.size() - pos, 100003);
+			writer->StartChunk(chunk++);
+			writer->Write(const_cast<uint8_t *>(data.data()) + pos, piece);
+			pos += piece;
+		}
+		writer->Finish();
+	}
+
+	std::shared_ptr<LoadFilter> reader = CreateBlockLoadFilter(std::make_shared<TestMemoryLoadFilter>(saved));
+	std::vector<uint8_t> loaded(data.size());
+	size_t pos = 0;
+	while (pos < loaded.size()) {
+		size_t read = reader->Read(loaded.data() + pos, std::min<size_t>(loaded.size() - pos, 65537));
+		REQUIRE(read > 0);
+		pos += read;
+	}
+	CHECK(loaded == data);
+
+	uint8_t extra;
+	CHECK(reader->Read(&extra, 1) == 0);
+}
+
+TEST_CASE("SavegameBlocks - Round trip")
+{
+	CheckBlockRoundTrip("none", 0);
+	CheckBlockRoundTrip("none", 1);
+	/* Spans several blocks, with a partial block at the end. */
+	CheckBlockRoundTrip("none", 9 * 1024 * 1024 + 17);
+	/* The default format, which compresses. */
+	CheckBlockRoundTrip("", 9 * 1024 * 1024 + 17);
+}
+
+TEST_CASE("SavegameBlocks - Corrupt block size")
+{
+	std::vector<uint8_t> saved;
+	{
+		std::shared_ptr<SaveFilter> writer = CreateBlockSaveFilter(std::make_shared<TestMemorySaveFilter>(saved), "none");
+		uint8_t byte = 42;
+		writer->Write(&byte, 1);
+		writer->Finish();
+	}
+
+	/* Claim the first block, following the 4 bytes tag, is almost 4 GiB large. */
+	saved[4] = saved[5] = saved[6] = saved[7] = 0xFF;
+
+	std::shared_ptr<LoadFilter> reader = CreateBlockLoadFilter(std::make_shared<TestMemoryLoadFilter>(saved));
+	uint8_t byte;
+	CHECK_THROWS(reader->Read(&byte, 1));
+}
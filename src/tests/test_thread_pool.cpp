@@ -0,0 +1,95 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file test_thread_pool.cpp Tests for the pool of worker threads. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../thread_pool.h"
+
+/**
+ * Run a ParallelFor and check how it split the range.
+ * @param count Number of items to process.
+ * @param min_chunk Minimum number of items per part.
+ */
+static void CheckParallelFor(size_t count, size_t min_chunk)
+{
+	ThreadPool &pool = ThreadPool::Get();
+
+	std::vector<uint8_t> processed(count, 0);
+	std::vector<std::pair<size_t, size_t>> parts;
+	std::mutex parts_lock;
+
+	pool.ParallelFor(count, min_chunk, [&](size_t first, size_t last) {
+		/* The parts are disjoint, so each item is written by one thread only. */
+		for (size_t i = first; i < last; i++) processed[i]++;
+		std::lock_guard<std::mutex> guard(parts_lock);
+		parts.emplace_back(first, last);
+	});
+
+	/* Every item is processed exactly once, and everything is done when ParallelFor returns. */
+	CHECK(std::all_of(processed.begin(), processed.end(), [](uint8_t times) { return times == 1; }));
+
+	if (count == 0) {
+		CHECK(parts.empty());
+		return;
+	}
+
+	CHECK(parts.size() <= pool.GetWorkerCount() + 1);
+	if (parts.size() > 1) {
+		for (const auto &[first, last] : parts) CHECK(last - first >= min_chunk);
+	}
+
+	std::sort(parts.begin(), parts.end());
+	CHECK(parts.front().first == 0);
+	CHECK(parts.back().second == count);
+	for (size_t i = 1; i < parts.size(); i++) CHECK(parts[i - 1].second == parts[i].first);
+}
+
+TEST_CASE("ThreadPool - ParallelFor partitioning")
+{
+	CheckParallelFor(0, 1);
+	CheckParallelFor(1, 1);
+	CheckParallelFor(7, 100);
+	CheckParallelFor(100, 0);
+	CheckParallelFor(1000, 1);
+	CheckParallelFor(1000, 64);
+	CheckParallelFor(123457, 1000);
+}
+
+TEST_CASE("ThreadPool - ParallelFor from within ParallelFor")
+{
+	std::atomic<size_t> total = 0;
+	ThreadPool::Get().ParallelFor(16, 1, [&total](size_t first, size_t last) {
+		for (size_t i = first; i < last; i++) {
+			ThreadPool::Get().ParallelFor(100, 10, [&total](size_t inner_first, size_t inner_last) {
+				total += inner_last - inner_first;
+			});
+		}
+	});
+	CHECK(total == 1600);
+}
+
+TEST_CASE("ThreadPool - Submit")
+{
+	ThreadPool &pool = ThreadPool::Get();
+
+	std::vector<int> results(32, 0);
+	std::vector<std::future<void>> futures;
+	for (size_t i = 0; i < results.size(); i++) {
+		futures.push_back(pool.Submit([&results, i]() { results[i] = static_cast<int>(i * i); }));
+	}
+	for (std::future<void> &future : futures) future.get();
+
+	for (size_t i = 0; i < results.size(); i++) CHECK(results[i] == static_cast<int>(i * i));
+
+	/* Exceptions of the work are passed on to whoever waits for it. */
+	std::future<void> failing = pool.Submit([]() { throw std::runtime_error("failed"); });
+	CHECK_THROWS_AS(failing.get(), std::runtime_error);
+}
@@ -0,0 +1,162 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file thread_pool.cpp Implementation of the pool of worker threads. */
+
+#include "stdafx.h"
+#include "thread.h"
+#include "thread_pool.h"
+
+#include "safeguards.h"
+
+/**
+ * Get the pool of worker threads, starting it when needed.
+ * @return The pool.
+ */
+/* static */ ThreadPool &ThreadPool::Get()
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+/**
+ * Start one worker per hardware thread, except for the one running the game.
+ * There is always at least one worker, so background work does not run on the game thread.
+ */
+ThreadPool::ThreadPool()
+{
+	uint threads = std::max(2U, std::thread::hardware_concurrency());
+	for (uint i = 1; i < threads; i++) {
+		std::thread t;
+		if (!StartNewThread(&t, "ottd:worker", [this]() { this->WorkerLoop(); })) break;
+		this->workers.push_back(std::move(t));
+	}
+	Debug(misc, 1, "Started {} worker threads", this->workers.size());
+}
+
+/** Stop and join all workers. */
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> guard(this->lock);
+		this->exit = true;
+	}
+	this->work_cv.notify_all();
+	for (std::thread &t : this->workers) {
+		if (t.joinable()) t.join();
+	}
+}
+
+/**
+ * Run the first waiting task, if any.
+ * @param lock Lock on #lock; it is released while running the task.
+ * @param batch When not \c nullptr, only run a task of the batch with this counter.
+ * @return True iff a task was run.
+ */
+bool ThreadPool::RunOneTask(std::unique_lock<std::mutex> &lock, const size_t *batch)
+{
+	auto it = this->tasks.begin();
+	if (batch != nullptr) it = std::find_if(it, this->tasks.end(), [batch](const Task &task) { return task.remaining == batch; });
+	if (it == this->tasks.end()) return false;
+
+	Task task = *it;
+	this->tasks.erase(it);
+
+	lock.unlock();
+	(*task.func)(task.first, task.last);
+	lock.lock();
+
+	if (--*task.remaining == 0) this->done_cv.notify_all();
+	return true;
+}
+
+/**
+ * Run the first waiting background task, if any.
+ * @param lock Lock on #lock; it is released while running the task.
+ * @return True iff a task was run.
+ */
+bool ThreadPool::RunOneBackgroundTask(std::unique_lock<std::mutex> &lock)
+{
+	if (this->background.empty()) return false;
+
+	std::packaged_task<void()> task = std::move(this->background.front());
+	this->background.pop_front();
+
+	lock.unlock();
+	task();
+	lock.lock();
+	return true;
+}
+
+/** Main loop of a worker thread. */
+void ThreadPool::WorkerLoop()
+{
+	std::unique_lock<std::mutex> lock(this->lock);
+	for (;;) {
+		this->work_cv.wait(lock, [this]() { return this->exit || !this->tasks.empty() || !this->background.empty(); });
+		if (this->RunOneTask(lock)) continue;
+		/* Background work still waiting when the game exits is dropped; its futures report a broken promise. */
+		if (this->exit) return;
+		this->RunOneBackgroundTask(lock);
+	}
+}
+
+/**
+ * Process the items [0, count) in parallel, and wait until all of them are processed.
+ * The range is split into at most one part per thread, each being at least \a min_chunk items.
+ * The calling thread processes parts too, so the call does not depend on any worker being available.
+ * It only processes parts of its own range, so several threads can call this at the same time without
+ * waiting for each other's work.
+ * @param count Number of items to process.
+ * @param min_chunk Minimum number of items worth handing to another thread.
+ * @param func Function processing a part of the range; it is called concurrently for disjoint parts.
+ */
+void ThreadPool::ParallelFor(size_t count, size_t min_chunk, const RangeFunc &func)
+{
+	if (count == 0) return;
+
+	size_t parts = std::min(this->workers.size() + 1, std::max<size_t>(count / std::max<size_t>(min_chunk, 1), 1));
+	if (parts <= 1) {
+		func(0, count);
+		return;
+	}
+
+	size_t remaining = parts;
+	std::unique_lock<std::mutex> lock(this->lock);
+	for (size_t i = 0; i < parts; i++) {
+		this->tasks.push_back({ &func, count * i / parts, count * (i + 1) / parts, &remaining });
+	}
+	this->work_cv.notify_all();
+
+	while (remaining != 0) {
+		if (!this->RunOneTask(lock, &remaining)) this->done_cv.wait(lock);
+	}
+}
+
+/**
+ * Run some work in the background on one of the workers.
+ * If no worker could be started, the work is run right away on the calling thread.
+ * @param func The work to do.
+ * @return Future that becomes ready once the work is done.
+ */
+std::future<void> ThreadPool::Submit(std::function<void()> &&func)
+{
+	std::packaged_task<void()> task(std::move(func));
+	std::future<void> result = task.get_future();
+
+	if (this->workers.empty()) {
+		task();
+		return result;
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(this->lock);
+		this->background.push_back(std::move(task));
+	}
+	this->work_cv.notify_one();
+	return result;
+}
@@ -0,0 +1,75 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file thread_pool.h Pool of worker threads to spread independent work over multiple cores. */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+/**
+ * Pool of worker threads, shared by everything that wants to split work into independent parts.
+ * The workers are started the first time the pool is used and live until the game exits.
+ * The work handed to the pool must not touch any state shared between the parts, as
+ * there is no guarantee in which order, or on which thread, the parts are run.
+ *
+ * Besides splitting work the game thread waits for, short background work can be
+ * submitted. Idle workers pick that up, but they always prefer the parts of a
+ * ParallelFor, and the thread calling ParallelFor never runs background work.
+ * Work that runs for a long time, like link graph jobs, gets its own thread instead,
+ * so it cannot hold up the short work. Background work that has not started when
+ * the game exits is dropped.
+ */
+class ThreadPool {
+public:
+	/** Function processing the items [first, last) of a range. */
+	using RangeFunc = std::function<void(size_t first, size_t last)>;
+
+	static ThreadPool &Get();
+
+	~ThreadPool();
+
+	/**
+	 * Get the number of worker threads, not counting the thread handing out the work.
+	 * @return The number of workers; 0 when everything runs on the calling thread.
+	 */
+	size_t GetWorkerCount() const { return this->workers.size(); }
+
+	void ParallelFor(size_t count, size_t min_chunk, const RangeFunc &func);
+	std::future<void> Submit(std::function<void()> &&func);
+
+private:
+	ThreadPool();
+
+	/** One part of the work handed to ParallelFor. */
+	struct Task {
+		const RangeFunc *func; ///< Function to call.
+		size_t first;          ///< First item to process.
+		size_t last;           ///< One past the last item to process.
+		size_t *remaining;     ///< Number of parts of the batch that are not finished yet.
+	};
+
+	bool RunOneTask(std::unique_lock<std::mutex> &lock, const size_t *batch = nullptr);
+	bool RunOneBackgroundTask(std::unique_lock<std::mutex> &lock);
+	void WorkerLoop();
+
+	std::vector<std::thread> workers;  ///< The worker threads.
+	std::deque<Task> tasks;            ///< Parts of work waiting for a thread.
+	std::deque<std::packaged_task<void()>> background; ///< Background work waiting for a worker.
+	std::mutex lock;                   ///< Lock for #tasks, #background, #exit and the batch counters.
+	std::condition_variable work_cv;   ///< Signalled when work is added or the pool shuts down.
+	std::condition_variable done_cv;   ///< Signalled when a batch is finished.
+	bool exit = false;                 ///< Whether the workers have to stop.
+};
+
+#endif /* THREAD_POOL_H */
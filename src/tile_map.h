@@ -116,6 +116,8 @@ inline bool IsInnerTile(Tile tile)
 	return x < Map::MaxX() && y < Map::MaxY() && ((x > 0 && y > 0) || !_settings_game.construction.freeform_edges);
 }
 
+void MarkTileLoopActive(TileIndex tile);
+
 /**
  * Set the type of a tile
  *
@@ -136,6 +138,7 @@ inline void SetTileType(Tile tile, TileType type)
 	 * the upper edges of the map are also VOID tiles. */
 	assert(IsInnerTile(tile) == (type != MP_VOID));
 	SB(tile.type(), 4, 4, type);
+	MarkTileLoopActive(tile);
 }
 
 /**
@@ -34,6 +34,8 @@ struct OrthogonalTileArea {
 
 	void Add(TileIndex to_add);
 
+	bool operator==(const OrthogonalTileArea &other) const = default;
+
 	/**
 	 * Clears the 'tile area', i.e. make the tile invalid.
 	 */
@@ -3523,6 +3523,7 @@ static CommandCost TownActionBribe(Town *t, DoCommandFlag flags)
 			for (Station *st : Station::Iterate()) {
 				if (st->town == t && st->owner == _current_company) {
 					for (GoodsEntry &ge : st->goods) ge.rating = 0;
+					st->rating_cargoes = ALL_CARGOTYPES;
 				}
 			}
 
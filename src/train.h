@@ -67,6 +67,7 @@ void GetTrainSpriteSize(EngineID engine, uint &width, uint &height, int &xoffs,
 
 bool TrainOnCrossing(TileIndex tile);
 void NormalizeTrainVehInDepot(const Train *u);
+void InvalidateTrainFreeRuns();
 
 /** Variables that are cached to improve performance and such */
 struct TrainCache {
@@ -83,6 +84,20 @@ struct TrainCache {
 	auto operator<=>(const TrainCache &) const = default;
 };
 
+/**
+ * The run of tiles ahead of the front engine that continue the line on plain track, up to the next junction,
+ * signal, station, crossing or change of slope. As long as neither the train nor the tracks changed, the line
+ * end check can be skipped and entering the next tile only has to pick its single track.
+ * This is not saved; an unset or outdated generation simply means the line ahead is checked again.
+ */
+struct TrainFreeRun {
+	TileIndex tile;      ///< Tile the front engine is on.
+	Direction direction; ///< Direction the front engine is moving in.
+	TrackBits track;     ///< Track the front engine is on.
+	uint8_t tiles;       ///< Number of tiles ahead of #tile that continue the line; never 0 for a valid run.
+	uint32_t generation; ///< Track layout generation the run was found in.
+};
+
 /**
  * 'Train' is either a loco or a wagon.
  */
@@ -102,6 +117,8 @@ struct Train final : public GroundVehicle<Train, VEH_TRAIN> {
 	TrackBits track;
 	TrainForceProceeding force_proceed;
 
+	TrainFreeRun free_run; ///< Cached result of the check for the end of the line; only used for the front engine.
+
 	/** We don't want GCC to zero our struct! It already is zeroed and has an index! */
 	Train() : GroundVehicleBase() {}
 	/** We want to 'destruct' the right class. */
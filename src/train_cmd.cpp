@@ -51,6 +51,9 @@ static TileIndex TrainApproachingCrossingTile(const Train *v);
 static void CheckIfTrainNeedsService(Train *v);
 static void CheckNextTrainTile(Train *v);
 
+/** Generation of the track layout; the cached free runs of trains are only valid within the generation they were found in. */
+static uint32_t _free_run_generation = 1;
+
 static const uint8_t _vehicle_initial_x_fract[4] = {10, 8, 4,  8};
 static const uint8_t _vehicle_initial_y_fract[4] = { 8, 4, 8, 10};
 
@@ -117,6 +120,7 @@ void Train::ConsistChanged(ConsistChangeFlags allowed_changes)
 	EngineID first_engine = this->IsFrontEngine() ? this->engine_type : INVALID_ENGINE;
 	this->gcache.cached_total_length = 0;
 	this->compatible_railtypes = RAILTYPES_NONE;
+	this->free_run.generation = 0;
 
 	bool train_can_tilt = true;
 	int16_t min_curve_speed_mod = INT16_MAX;
@@ -1859,6 +1863,7 @@ static inline void MaybeBarCrossingWithSound(TileIndex tile)
 {
 	if (!IsCrossingBarred(tile)) {
 		SetCrossingReservation(tile, true);
+		InvalidateReservationCache(tile);
 		UpdateLevelCrossing(tile, true);
 	}
 }
@@ -2317,6 +2322,7 @@ static bool CheckTrainStayInDepot(Train *v)
 	}
 
 	SetDepotReservation(v->tile, true);
+	InvalidateReservationCache(v->tile);
 	if (_settings_client.gui.show_track_reservation) MarkTileDirtyByTile(v->tile);
 
 	VehicleServiceInDepot(v);
@@ -2358,6 +2364,8 @@ static void ClearPathReservation(const Train *v, TileIndex tile, Trackdir track_
 				/* Free the reservation only if no other train is on the tiles. */
 				SetTunnelBridgeReservation(tile, false);
 				SetTunnelBridgeReservation(end, false);
+				InvalidateReservationCache(tile);
+				InvalidateReservationCache(end);
 
 				if (_settings_client.gui.show_track_reservation) {
 					if (IsBridge(tile)) {
@@ -2880,6 +2888,7 @@ bool TryPathReserve(Train *v, bool mark_as_stuck, bool first_tile_okay)
 	/* If we are in a depot, tentatively reserve the depot. */
 	if (v->track == TRACK_BIT_DEPOT) {
 		SetDepotReservation(v->tile, true);
+		InvalidateReservationCache(v->tile);
 		if (_settings_client.gui.show_track_reservation) MarkTileDirtyByTile(v->tile);
 	}
 
@@ -2894,7 +2903,10 @@ bool TryPathReserve(Train *v, bool mark_as_stuck, bool first_tile_okay)
 
 	if (!res_made) {
 		/* Free the depot reservation as well. */
-		if (v->track == TRACK_BIT_DEPOT) SetDepotReservation(v->tile, false);
+		if (v->track == TRACK_BIT_DEPOT) {
+			SetDepotReservation(v->tile, false);
+			InvalidateReservationCache(v->tile);
+		}
 		return false;
 	}
 
@@ -3099,6 +3111,7 @@ uint Train::Crash(bool flooded)
 				/* ClearPathReservation will not free the wormhole exit
 				 * if the train has just entered the wormhole. */
 				SetTunnelBridgeReservation(GetOtherTunnelBridgeEnd(v->tile), false);
+				InvalidateReservationCache(GetOtherTunnelBridgeEnd(v->tile));
 			}
 		}
 
@@ -3245,6 +3258,68 @@ static Vehicle *CheckTrainAtSignal(Vehicle *v, void *data)
 	return t;
 }
 
+/** Maximum number of tiles ahead of a train that are looked at for a free run. */
+static const uint8_t MAX_TRAIN_FREE_RUN_TILES = 32;
+
+/**
+ * Check whether the front engine is on the tile of its free run, moving the same way as when the run was found.
+ * @param v The front engine.
+ * @return True iff the tiles ahead of the train are known to continue the line.
+ */
+static inline bool IsOnTrainFreeRun(const Train *v)
+{
+	const TrainFreeRun &free_run = v->free_run;
+	return free_run.generation == _free_run_generation && free_run.tile == v->tile && free_run.direction == v->direction && free_run.track == v->track;
+}
+
+/**
+ * Count the tiles ahead that continue the line on plain track: they only have the single track
+ * the train enters, which does not cross its current track, have no signals, can be used by the
+ * train and have the same slope as the tile before them.
+ * @param v The front engine.
+ * @param tile The tile ahead of the train.
+ * @param enterdir The direction the train enters that tile in.
+ * @return The number of tiles, at most #MAX_TRAIN_FREE_RUN_TILES.
+ */
+static uint8_t FindTrainFreeRunLength(const Train *v, TileIndex tile, DiagDirection enterdir)
+{
+	Track track = FindFirstTrack(v->track);
+	Slope slope = GetTileSlope(v->tile);
+	uint8_t tiles = 0;
+	while (tiles < MAX_TRAIN_FREE_RUN_TILES) {
+		if (!IsPlainRailTile(tile) || HasSignals(tile) || GetTileSlope(tile) != slope || !CheckCompatibleRail(v, tile)) break;
+
+		const TrackBits bits = GetTrackBits(tile);
+		if (!HasExactlyOneBit(bits) || (bits & DiagdirReachesTracks(enterdir)) == TRACK_BIT_NONE || (bits & TrackCrossesTracks(track)) != TRACK_BIT_NONE) break;
+
+		tiles++;
+		track = FindFirstTrack(bits);
+		enterdir = TrackdirToExitdir(TrackEnterdirToTrackdir(track, enterdir));
+		tile = TileAddByDiagDir(tile, enterdir);
+		if (!IsValidTile(tile)) break;
+	}
+	return tiles;
+}
+
+/**
+ * Get the track the front engine takes on the first tile of its free run.
+ * Only the reservation of the tile can differ from when the run was found, and when the train has to
+ * reserve its own path on an unreserved tile, the full track choice has to be made.
+ * @param tile The tile being entered.
+ * @param enterdir The direction the tile is entered in.
+ * @return The single track of the tile, or #TRACK_BIT_NONE when the track has to be chosen normally.
+ * @pre The front engine is on its free run, so \a tile is the first tile of the run.
+ */
+static TrackBits GetTrainFreeRunTrack(TileIndex tile, DiagDirection enterdir)
+{
+	assert(IsPlainRailTile(tile) && !HasSignals(tile));
+	const TrackBits bits = GetTrackBits(tile);
+	assert(HasExactlyOneBit(bits) && (bits & DiagdirReachesTracks(enterdir)) != TRACK_BIT_NONE);
+
+	if (_settings_game.pf.reserve_paths && !HasReservedTracks(tile, bits)) return TRACK_BIT_NONE;
+	return bits;
+}
+
 /**
  * Move a vehicle chain one movement stop forwards.
  * @param v First vehicle to move.
@@ -3294,122 +3369,128 @@ bool TrainController(Train *v, Vehicle *nomove, bool reverse)
 				enterdir = DiagdirBetweenTiles(gp.old_tile, gp.new_tile);
 				assert(IsValidDiagDirection(enterdir));
 
-				/* Get the status of the tracks in the new tile and mask
-				 * away the bits that aren't reachable. */
-				TrackStatus ts = GetTileTrackStatus(gp.new_tile, TRANSPORT_RAIL, 0, ReverseDiagDir(enterdir));
-				TrackdirBits reachable_trackdirs = DiagdirReachesTrackdirs(enterdir);
-
-				TrackdirBits trackdirbits = TrackStatusToTrackdirBits(ts) & reachable_trackdirs;
-				TrackBits red_signals = TrackdirBitsToTrackBits(TrackStatusToRedSignals(ts) & reachable_trackdirs);
-
-				TrackBits bits = TrackdirBitsToTrackBits(trackdirbits);
-				if (Rail90DegTurnDisallowed(GetTileRailType(gp.old_tile), GetTileRailType(gp.new_tile)) && prev == nullptr) {
-					/* We allow wagons to make 90 deg turns, because forbid_90_deg
-					 * can be switched on halfway a turn */
-					bits &= ~TrackCrossesTracks(FindFirstTrack(v->track));
-				}
-
-				if (bits == TRACK_BIT_NONE) goto invalid_rail;
-
-				/* Check if the new tile constrains tracks that are compatible
-				 * with the current train, if not, bail out. */
-				if (!CheckCompatibleRail(v, gp.new_tile)) goto invalid_rail;
-
-				TrackBits chosen_track;
-				if (prev == nullptr) {
-					/* Currently the locomotive is active. Determine which one of the
-					 * available tracks to choose */
-					chosen_track = TrackToTrackBits(ChooseTrainTrack(v, gp.new_tile, enterdir, bits, false, nullptr, true));
-					assert(chosen_track & (bits | GetReservedTrackbits(gp.new_tile)));
-
-					if (v->force_proceed != TFP_NONE && IsPlainRailTile(gp.new_tile) && HasSignals(gp.new_tile)) {
-						/* For each signal we find decrease the counter by one.
-						 * We start at two, so the first signal we pass decreases
-						 * this to one, then if we reach the next signal it is
-						 * decreased to zero and we won't pass that new signal. */
-						Trackdir dir = FindFirstTrackdir(trackdirbits);
-						if (HasSignalOnTrackdir(gp.new_tile, dir) ||
-								(HasSignalOnTrackdir(gp.new_tile, ReverseTrackdir(dir)) &&
-								GetSignalType(gp.new_tile, TrackdirToTrack(dir)) != SIGTYPE_PBS)) {
-							/* However, we do not want to be stopped by PBS signals
-							 * entered via the back. */
-							v->force_proceed = (v->force_proceed == TFP_SIGNAL) ? TFP_STUCK : TFP_NONE;
-							SetWindowDirty(WC_VEHICLE_VIEW, v->index);
-						}
+				/* Inside a free run the front engine enters plain track with a single track, which it takes without further checks. */
+				bool free_run = prev == nullptr && v->IsFrontEngine() && IsOnTrainFreeRun(v);
+				TrackBits chosen_track = free_run ? GetTrainFreeRunTrack(gp.new_tile, enterdir) : TRACK_BIT_NONE;
+				if (chosen_track != TRACK_BIT_NONE) {
+					TryReserveRailTrack(gp.new_tile, FindFirstTrack(chosen_track), false);
+				} else {
+					/* Get the status of the tracks in the new tile and mask
+					 * away the bits that aren't reachable. */
+					TrackStatus ts = GetTileTrackStatus(gp.new_tile, TRANSPORT_RAIL, 0, ReverseDiagDir(enterdir));
+					TrackdirBits reachable_trackdirs = DiagdirReachesTrackdirs(enterdir);
+
+					TrackdirBits trackdirbits = TrackStatusToTrackdirBits(ts) & reachable_trackdirs;
+					TrackBits red_signals = TrackdirBitsToTrackBits(TrackStatusToRedSignals(ts) & reachable_trackdirs);
+
+					TrackBits bits = TrackdirBitsToTrackBits(trackdirbits);
+					if (Rail90DegTurnDisallowed(GetTileRailType(gp.old_tile), GetTileRailType(gp.new_tile)) && prev == nullptr) {
+						/* We allow wagons to make 90 deg turns, because forbid_90_deg
+						 * can be switched on halfway a turn */
+						bits &= ~TrackCrossesTracks(FindFirstTrack(v->track));
 					}
 
-					/* Check if it's a red signal and that force proceed is not clicked. */
-					if ((red_signals & chosen_track) && v->force_proceed == TFP_NONE) {
-						/* In front of a red signal */
-						Trackdir i = FindFirstTrackdir(trackdirbits);
-
-						/* Don't handle stuck trains here. */
-						if (HasBit(v->flags, VRF_TRAIN_STUCK)) return false;
-
-						if (!HasSignalOnTrackdir(gp.new_tile, ReverseTrackdir(i))) {
-							v->cur_speed = 0;
-							v->subspeed = 0;
-							v->progress = 255; // make sure that every bit of acceleration will hit the signal again, so speed stays 0.
-							if (!_settings_game.pf.reverse_at_signals || ++v->wait_counter < _settings_game.pf.wait_oneway_signal * Ticks::DAY_TICKS * 2) return false;
-						} else if (HasSignalOnTrackdir(gp.new_tile, i)) {
-							v->cur_speed = 0;
-							v->subspeed = 0;
-							v->progress = 255; // make sure that every bit of acceleration will hit the signal again, so speed stays 0.
-							if (!_settings_game.pf.reverse_at_signals || ++v->wait_counter < _settings_game.pf.wait_twoway_signal * Ticks::DAY_TICKS * 2) {
-								DiagDirection exitdir = TrackdirToExitdir(i);
-								TileIndex o_tile = TileAddByDiagDir(gp.new_tile, exitdir);
-
-								exitdir = ReverseDiagDir(exitdir);
-
-								/* check if a train is waiting on the other side */
-								if (!HasVehicleOnPos(o_tile, &exitdir, &CheckTrainAtSignal)) return false;
+					if (bits == TRACK_BIT_NONE) goto invalid_rail;
+
+					/* Check if the new tile constrains tracks that are compatible
+					 * with the current train, if not, bail out. */
+					if (!CheckCompatibleRail(v, gp.new_tile)) goto invalid_rail;
+
+					if (prev == nullptr) {
+						/* Currently the locomotive is active. Determine which one of the
+						 * available tracks to choose */
+						chosen_track = TrackToTrackBits(ChooseTrainTrack(v, gp.new_tile, enterdir, bits, false, nullptr, true));
+						assert(chosen_track & (bits | GetReservedTrackbits(gp.new_tile)));
+
+						if (v->force_proceed != TFP_NONE && IsPlainRailTile(gp.new_tile) && HasSignals(gp.new_tile)) {
+							/* For each signal we find decrease the counter by one.
+							 * We start at two, so the first signal we pass decreases
+							 * this to one, then if we reach the next signal it is
+							 * decreased to zero and we won't pass that new signal. */
+							Trackdir dir = FindFirstTrackdir(trackdirbits);
+							if (HasSignalOnTrackdir(gp.new_tile, dir) ||
+									(HasSignalOnTrackdir(gp.new_tile, ReverseTrackdir(dir)) &&
+									GetSignalType(gp.new_tile, TrackdirToTrack(dir)) != SIGTYPE_PBS)) {
+								/* However, we do not want to be stopped by PBS signals
+								 * entered via the back. */
+								v->force_proceed = (v->force_proceed == TFP_SIGNAL) ? TFP_STUCK : TFP_NONE;
+								SetWindowDirty(WC_VEHICLE_VIEW, v->index);
 							}
 						}
 
-						/* If we would reverse but are currently in a PBS block and
-						 * reversing of stuck trains is disabled, don't reverse.
-						 * This does not apply if the reason for reversing is a one-way
-						 * signal blocking us, because a train would then be stuck forever. */
-						if (!_settings_game.pf.reverse_at_signals && !HasOnewaySignalBlockingTrackdir(gp.new_tile, i) &&
-								UpdateSignalsOnSegment(v->tile, enterdir, v->owner) == SIGSEG_PBS) {
-							v->wait_counter = 0;
-							return false;
+						/* Check if it's a red signal and that force proceed is not clicked. */
+						if ((red_signals & chosen_track) && v->force_proceed == TFP_NONE) {
+							/* In front of a red signal */
+							Trackdir i = FindFirstTrackdir(trackdirbits);
+
+							/* Don't handle stuck trains here. */
+							if (HasBit(v->flags, VRF_TRAIN_STUCK)) return false;
+
+							if (!HasSignalOnTrackdir(gp.new_tile, ReverseTrackdir(i))) {
+								v->cur_speed = 0;
+								v->subspeed = 0;
+								v->progress = 255; // make sure that every bit of acceleration will hit the signal again, so speed stays 0.
+								if (!_settings_game.pf.reverse_at_signals || ++v->wait_counter < _settings_game.pf.wait_oneway_signal * Ticks::DAY_TICKS * 2) return false;
+							} else if (HasSignalOnTrackdir(gp.new_tile, i)) {
+								v->cur_speed = 0;
+								v->subspeed = 0;
+								v->progress = 255; // make sure that every bit of acceleration will hit the signal again, so speed stays 0.
+								if (!_settings_game.pf.reverse_at_signals || ++v->wait_counter < _settings_game.pf.wait_twoway_signal * Ticks::DAY_TICKS * 2) {
+									DiagDirection exitdir = TrackdirToExitdir(i);
+									TileIndex o_tile = TileAddByDiagDir(gp.new_tile, exitdir);
+
+									exitdir = ReverseDiagDir(exitdir);
+
+									/* check if a train is waiting on the other side */
+									if (!HasVehicleOnPos(o_tile, &exitdir, &CheckTrainAtSignal)) return false;
+								}
+							}
+
+							/* If we would reverse but are currently in a PBS block and
+							 * reversing of stuck trains is disabled, don't reverse.
+							 * This does not apply if the reason for reversing is a one-way
+							 * signal blocking us, because a train would then be stuck forever. */
+							if (!_settings_game.pf.reverse_at_signals && !HasOnewaySignalBlockingTrackdir(gp.new_tile, i) &&
+									UpdateSignalsOnSegment(v->tile, enterdir, v->owner) == SIGSEG_PBS) {
+								v->wait_counter = 0;
+								return false;
+							}
+							goto reverse_train_direction;
+						} else {
+							TryReserveRailTrack(gp.new_tile, TrackBitsToTrack(chosen_track), false);
 						}
-						goto reverse_train_direction;
 					} else {
-						TryReserveRailTrack(gp.new_tile, TrackBitsToTrack(chosen_track), false);
-					}
-				} else {
-					/* The wagon is active, simply follow the prev vehicle. */
-					if (prev->tile == gp.new_tile) {
-						/* Choose the same track as prev */
-						if (prev->track == TRACK_BIT_WORMHOLE) {
-							/* Vehicles entering tunnels enter the wormhole earlier than for bridges.
-							 * However, just choose the track into the wormhole. */
-							assert(IsTunnel(prev->tile));
-							chosen_track = bits;
+						/* The wagon is active, simply follow the prev vehicle. */
+						if (prev->tile == gp.new_tile) {
+							/* Choose the same track as prev */
+							if (prev->track == TRACK_BIT_WORMHOLE) {
+								/* Vehicles entering tunnels enter the wormhole earlier than for bridges.
+								 * However, just choose the track into the wormhole. */
+								assert(IsTunnel(prev->tile));
+								chosen_track = bits;
+							} else {
+								chosen_track = prev->track;
+							}
 						} else {
-							chosen_track = prev->track;
+							/* Choose the track that leads to the tile where prev is.
+							 * This case is active if 'prev' is already on the second next tile, when 'v' just enters the next tile.
+							 * I.e. when the tile between them has only space for a single vehicle like
+							 *  1) horizontal/vertical track tiles and
+							 *  2) some orientations of tunnel entries, where the vehicle is already inside the wormhole at 8/16 from the tile edge.
+							 *     Is also the train just reversing, the wagon inside the tunnel is 'on' the tile of the opposite tunnel entry.
+							 */
+							static const TrackBits _connecting_track[DIAGDIR_END][DIAGDIR_END] = {
+								{TRACK_BIT_X,     TRACK_BIT_LOWER, TRACK_BIT_NONE,  TRACK_BIT_LEFT },
+								{TRACK_BIT_UPPER, TRACK_BIT_Y,     TRACK_BIT_LEFT,  TRACK_BIT_NONE },
+								{TRACK_BIT_NONE,  TRACK_BIT_RIGHT, TRACK_BIT_X,     TRACK_BIT_UPPER},
+								{TRACK_BIT_RIGHT, TRACK_BIT_NONE,  TRACK_BIT_LOWER, TRACK_BIT_Y    }
+							};
+							DiagDirection exitdir = DiagdirBetweenTiles(gp.new_tile, prev->tile);
+							assert(IsValidDiagDirection(exitdir));
+							chosen_track = _connecting_track[enterdir][exitdir];
 						}
-					} else {
-						/* Choose the track that leads to the tile where prev is.
-						 * This case is active if 'prev' is already on the second next tile, when 'v' just enters the next tile.
-						 * I.e. when the tile between them has only space for a single vehicle like
-						 *  1) horizontal/vertical track tiles and
-						 *  2) some orientations of tunnel entries, where the vehicle is already inside the wormhole at 8/16 from the tile edge.
-						 *     Is also the train just reversing, the wagon inside the tunnel is 'on' the tile of the opposite tunnel entry.
-						 */
-						static const TrackBits _connecting_track[DIAGDIR_END][DIAGDIR_END] = {
-							{TRACK_BIT_X,     TRACK_BIT_LOWER, TRACK_BIT_NONE,  TRACK_BIT_LEFT },
-							{TRACK_BIT_UPPER, TRACK_BIT_Y,     TRACK_BIT_LEFT,  TRACK_BIT_NONE },
-							{TRACK_BIT_NONE,  TRACK_BIT_RIGHT, TRACK_BIT_X,     TRACK_BIT_UPPER},
-							{TRACK_BIT_RIGHT, TRACK_BIT_NONE,  TRACK_BIT_LOWER, TRACK_BIT_Y    }
-						};
-						DiagDirection exitdir = DiagdirBetweenTiles(gp.new_tile, prev->tile);
-						assert(IsValidDiagDirection(exitdir));
-						chosen_track = _connecting_track[enterdir][exitdir];
+						chosen_track &= bits;
 					}
-					chosen_track &= bits;
 				}
 
 				/* Make sure chosen track is a valid track */
@@ -3468,6 +3549,17 @@ bool TrainController(Train *v, Vehicle *nomove, bool reverse)
 				if (v->IsFrontEngine()) {
 					v->wait_counter = 0;
 
+					/* Move the free run along with the train, or forget it when it ends here. */
+					if (free_run && v->free_run.generation == _free_run_generation) {
+						if (--v->free_run.tiles == 0) {
+							v->free_run.generation = 0;
+						} else {
+							v->free_run.tile = v->tile;
+							v->free_run.direction = v->direction;
+							v->free_run.track = v->track;
+						}
+					}
+
 					/* If we are approaching a crossing that is reserved, play the sound now. */
 					TileIndex crossing = TrainApproachingCrossingTile(v);
 					if (crossing != INVALID_TILE && HasCrossingReservation(crossing) && _settings_client.sound.ambient) SndPlayTileFx(SND_0E_LEVEL_CROSSING, crossing);
@@ -3877,6 +3969,9 @@ static bool TrainCheckIfLineEnds(Train *v, bool reverse)
 		v->vehstatus &= ~VS_TRAIN_SLOWING;
 	}
 
+	/* Nothing changed since the line ahead was found to continue on plain track? */
+	if (IsOnTrainFreeRun(v)) return true;
+
 	if (!TrainCanLeaveTile(v)) return true;
 
 	/* Determine the non-diagonal direction in which we will exit this tile */
@@ -3910,9 +4005,27 @@ static bool TrainCheckIfLineEnds(Train *v, bool reverse)
 	/* approaching a rail/road crossing? then make it red */
 	if (IsLevelCrossingTile(tile)) MaybeBarCrossingWithSound(tile);
 
+	/* Plain track without signals only changes with the track layout, so until the train reaches the end of
+	 * the plain track ahead the check can be skipped, and the tiles on the way need no full track choice. */
+	uint8_t free_run_tiles = FindTrainFreeRunLength(v, tile, dir);
+	if (free_run_tiles > 0) v->free_run = { v->tile, v->direction, v->track, free_run_tiles, _free_run_generation };
+
 	return true;
 }
 
+/**
+ * Forget where the line ahead of trains was found to continue, because the tracks or their owners changed.
+ */
+void InvalidateTrainFreeRuns()
+{
+	_free_run_generation++;
+	/* Zero is reserved for trains that never checked the line ahead. */
+	if (_free_run_generation == 0) {
+		_free_run_generation = 1;
+		for (Train *v : Train::Iterate()) v->free_run.generation = 0;
+	}
+}
+
 
 static bool TrainLocoHandler(Train *v, bool mode)
 {
@@ -51,11 +51,13 @@
 #include "linkgraph/linkgraph.h"
 #include "linkgraph/refresh.h"
 #include "framerate_type.h"
+#include "thread_pool.h"
 #include "autoreplace_cmd.h"
 #include "misc_cmd.h"
 #include "train_cmd.h"
 #include "vehicle_cmd.h"
 #include "newgrf_roadstop.h"
+#include "pbs.h"
 #include "timer/timer.h"
 #include "timer/timer_game_calendar.h"
 #include "timer/timer_game_economy.h"
@@ -372,32 +374,80 @@ Vehicle::Vehicle(VehicleType type)
 	this->last_loading_station = INVALID_STATION;
 }
 
-/* Size of the hash, 6 = 64 x 64, 7 = 128 x 128. Larger sizes will (in theory) reduce hash
- * lookup times at the expense of memory usage. */
-const int HASH_BITS = 7;
-const int HASH_SIZE = 1 << HASH_BITS;
-const int HASH_MASK = HASH_SIZE - 1;
-const int TOTAL_HASH_SIZE = 1 << (HASH_BITS * 2);
-const int TOTAL_HASH_MASK = TOTAL_HASH_SIZE - 1;
+/* The tile hash has one bucket per tile, so looking up the vehicles on a tile only visits vehicles
+ * on that tile. To limit the memory usage on the largest maps, a bucket covers a square of 2x2,
+ * 4x4, ... tiles when the map has more tiles than this number of bits allows for. */
+static const uint MAX_TILE_HASH_BITS = 22;
 
-/* Resolution of the hash, 0 = 1*1 tile, 1 = 2*2 tiles, 2 = 4*4 tiles, etc.
- * Profiling results show that 0 is fastest. */
-const int HASH_RES = 0;
+static std::vector<Vehicle *> _vehicle_tile_hash; ///< Heads of the vehicle chains of the tile hash.
+static uint _vehicle_tile_hash_res;                ///< Resolution of the tile hash, 0 = 1*1 tile, 1 = 2*2 tiles, 2 = 4*4 tiles, etc.
+static uint _vehicle_tile_hash_bits_x;             ///< Number of bits of the X coordinate of a tile hash bucket.
 
-static Vehicle *_vehicle_tile_hash[TOTAL_HASH_SIZE];
+/**
+ * Get the tile hash bucket of a tile position.
+ * Positions outside of the map share the buckets at the map's edge; #VehicleFromPosXY clamps the same way.
+ * @param x The X tile coordinate, possibly outside of the map.
+ * @param y The Y tile coordinate, possibly outside of the map.
+ * @return Index into #_vehicle_tile_hash.
+ */
+static inline uint GetVehicleTileHashBucket(int x, int y)
+{
+	x = Clamp(x, 0, (int)Map::MaxX());
+	y = Clamp(y, 0, (int)Map::MaxY());
+	return ((y >> _vehicle_tile_hash_res) << _vehicle_tile_hash_bits_x) | (x >> _vehicle_tile_hash_res);
+}
+
+/**
+ * Get the tile hash bucket of a vehicle.
+ * @param v The vehicle.
+ * @return Index into #_vehicle_tile_hash.
+ */
+static inline uint GetVehicleTileHashBucket(const Vehicle *v)
+{
+	/* The tile of a vehicle outside of the map, e.g. a disaster flying off it, wraps around the map.
+	 * Use its position instead, so it is in the bucket at the map's edge where a search by position looks. */
+	if (v->x_pos < 0 || v->y_pos < 0 || v->x_pos >= (int)(Map::SizeX() * TILE_SIZE) || v->y_pos >= (int)(Map::SizeY() * TILE_SIZE)) {
+		return GetVehicleTileHashBucket(v->x_pos / (int)TILE_SIZE, v->y_pos / (int)TILE_SIZE);
+	}
+	return GetVehicleTileHashBucket(TileX(v->tile), TileY(v->tile));
+}
 
-static Vehicle *VehicleFromTileHash(int xl, int yl, int xu, int yu, void *data, VehicleFromPosProc *proc, bool find_first)
+/**
+ * Size the vehicle tile hash to the just allocated map.
+ * Vehicles in the pool must not be in the old hash anymore, i.e. the pool has to be cleaned.
+ */
+void AllocateVehicleTileHash()
 {
-	for (int y = yl; ; y = (y + (1 << HASH_BITS)) & (HASH_MASK << HASH_BITS)) {
-		for (int x = xl; ; x = (x + 1) & HASH_MASK) {
-			Vehicle *v = _vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
+	uint bits = Map::LogX() + Map::LogY();
+	_vehicle_tile_hash_res = 0;
+	while (bits - 2 * _vehicle_tile_hash_res > MAX_TILE_HASH_BITS) _vehicle_tile_hash_res++;
+	_vehicle_tile_hash_bits_x = Map::LogX() - _vehicle_tile_hash_res;
+
+	_vehicle_tile_hash.assign(static_cast<size_t>(1) << (bits - 2 * _vehicle_tile_hash_res), nullptr);
+}
+
+/**
+ * Call \a proc for all vehicles in the tile hash buckets of the given area.
+ * @param xl The lowest X tile coordinate of the area.
+ * @param yl The lowest Y tile coordinate of the area.
+ * @param xu The highest X tile coordinate of the area.
+ * @param yu The highest Y tile coordinate of the area.
+ * @param data Arbitrary data passed to proc
+ * @param proc The proc that determines whether a vehicle will be "found".
+ * @param find_first Whether to return on the first found or iterate over
+ *                   all vehicles
+ * @return the best matching or first vehicle (depending on find_first).
+ */
+static Vehicle *VehicleFromTileHash(uint xl, uint yl, uint xu, uint yu, void *data, VehicleFromPosProc *proc, bool find_first)
+{
+	for (uint y = yl >> _vehicle_tile_hash_res; y <= yu >> _vehicle_tile_hash_res; y++) {
+		for (uint x = xl >> _vehicle_tile_hash_res; x <= xu >> _vehicle_tile_hash_res; x++) {
+			Vehicle *v = _vehicle_tile_hash[(y << _vehicle_tile_hash_bits_x) | x];
 			for (; v != nullptr; v = v->hash_tile_next) {
 				Vehicle *a = proc(v, data);
 				if (find_first && a != nullptr) return a;
 			}
-			if (x == xu) break;
 		}
-		if (y == yu) break;
 	}
 
 	return nullptr;
@@ -419,11 +469,11 @@ static Vehicle *VehicleFromPosXY(int x, int y, void *data, VehicleFromPosProc *p
 {
 	const int COLL_DIST = 6;
 
-	/* Hash area to scan is from xl,yl to xu,yu */
-	int xl = GB((x - COLL_DIST) / TILE_SIZE, HASH_RES, HASH_BITS);
-	int xu = GB((x + COLL_DIST) / TILE_SIZE, HASH_RES, HASH_BITS);
-	int yl = GB((y - COLL_DIST) / TILE_SIZE, HASH_RES, HASH_BITS) << HASH_BITS;
-	int yu = GB((y + COLL_DIST) / TILE_SIZE, HASH_RES, HASH_BITS) << HASH_BITS;
+	/* Tile area to scan is from xl,yl to xu,yu */
+	uint xl = Clamp((x - COLL_DIST) / (int)TILE_SIZE, 0, (int)Map::MaxX());
+	uint xu = Clamp((x + COLL_DIST) / (int)TILE_SIZE, 0, (int)Map::MaxX());
+	uint yl = Clamp((y - COLL_DIST) / (int)TILE_SIZE, 0, (int)Map::MaxY());
+	uint yu = Clamp((y + COLL_DIST) / (int)TILE_SIZE, 0, (int)Map::MaxY());
 
 	return VehicleFromTileHash(xl, yl, xu, yu, data, proc, find_first);
 }
@@ -475,10 +525,7 @@ bool HasVehicleOnPosXY(int x, int y, void *data, VehicleFromPosProc *proc)
  */
 static Vehicle *VehicleFromPos(TileIndex tile, void *data, VehicleFromPosProc *proc, bool find_first)
 {
-	int x = GB(TileX(tile), HASH_RES, HASH_BITS);
-	int y = GB(TileY(tile), HASH_RES, HASH_BITS) << HASH_BITS;
-
-	Vehicle *v = _vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
+	Vehicle *v = _vehicle_tile_hash[GetVehicleTileHashBucket(TileX(tile), TileY(tile))];
 	for (; v != nullptr; v = v->hash_tile_next) {
 		if (v->tile != tile) continue;
 
@@ -624,9 +671,7 @@ static void UpdateVehicleTileHash(Vehicle *v, bool remove)
 	if (remove) {
 		new_hash = nullptr;
 	} else {
-		int x = GB(TileX(v->tile), HASH_RES, HASH_BITS);
-		int y = GB(TileY(v->tile), HASH_RES, HASH_BITS) << HASH_BITS;
-		new_hash = &_vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
+		new_hash = &_vehicle_tile_hash[GetVehicleTileHashBucket(v)];
 	}
 
 	if (old_hash == new_hash) return;
@@ -679,7 +724,7 @@ void ResetVehicleHash()
 {
 	for (Vehicle *v : Vehicle::Iterate()) { v->hash_tile_current = nullptr; }
 	memset(_vehicle_viewport_hash, 0, sizeof(_vehicle_viewport_hash));
-	memset(_vehicle_tile_hash, 0, sizeof(_vehicle_tile_hash));
+	std::fill(_vehicle_tile_hash.begin(), _vehicle_tile_hash.end(), nullptr);
 }
 
 void ResetVehicleColourMap()
@@ -694,6 +739,12 @@ void ResetVehicleColourMap()
 using AutoreplaceMap = std::map<VehicleID, bool>;
 static AutoreplaceMap _vehicles_to_autoreplace;
 
+/** Vehicles of which the cargo has to be aged at the end of this tick. */
+static std::vector<VehicleID> _vehicles_to_age_cargo;
+
+/** Minimum number of vehicles worth aging cargo for on another thread. */
+static const size_t MIN_PARALLEL_CARGO_AGING = 64;
+
 void InitializeVehicles()
 {
 	_vehicles_to_autoreplace.clear();
@@ -981,9 +1032,35 @@ static void RunEconomyVehicleDayProc()
 	}
 }
 
+/**
+ * Age the cargo of all vehicles that reached the end of their cargo aging period this tick.
+ * Every vehicle has its own cargo list, and aging does not look at anything else, so the
+ * vehicles can be processed in any order, or concurrently, with the same result.
+ */
+static void AgeVehicleCargo()
+{
+	/* Weed out vehicles that were removed after they were scheduled for aging. */
+	std::vector<VehicleCargoList *> lists;
+	lists.reserve(_vehicles_to_age_cargo.size());
+	for (VehicleID index : _vehicles_to_age_cargo) {
+		Vehicle *v = Vehicle::GetIfValid(index);
+		if (v != nullptr) lists.push_back(&v->cargo);
+	}
+	_vehicles_to_age_cargo.clear();
+
+	if (_settings_client.gui.threaded_game_loop) {
+		ThreadPool::Get().ParallelFor(lists.size(), MIN_PARALLEL_CARGO_AGING, [&lists](size_t first, size_t last) {
+			for (size_t i = first; i < last; i++) lists[i]->AgeCargo();
+		});
+	} else {
+		for (VehicleCargoList *list : lists) list->AgeCargo();
+	}
+}
+
 void CallVehicleTicks()
 {
 	_vehicles_to_autoreplace.clear();
+	_vehicles_to_age_cargo.clear();
 
 	RunEconomyVehicleDayProc();
 
@@ -1019,7 +1096,7 @@ void CallVehicleTicks()
 				if (v->vcache.cached_cargo_age_period != 0) {
 					v->cargo_age_counter = std::min(v->cargo_age_counter, v->vcache.cached_cargo_age_period);
 					if (--v->cargo_age_counter == 0) {
-						v->cargo.AgeCargo();
+						_vehicles_to_age_cargo.push_back(v->index);
 						v->cargo_age_counter = v->vcache.cached_cargo_age_period;
 					}
 				}
@@ -1069,6 +1146,10 @@ void CallVehicleTicks()
 		}
 	}
 
+	FindDeferredShipPaths();
+
+	AgeVehicleCargo();
+
 	Backup<CompanyID> cur_company(_current_company);
 	for (auto &it : _vehicles_to_autoreplace) {
 		Vehicle *v = Vehicle::Get(it.first);
@@ -1560,6 +1641,7 @@ void VehicleEnterDepot(Vehicle *v)
 			SetWindowClassesDirty(WC_TRAINS_LIST);
 			/* Clear path reservation */
 			SetDepotReservation(t->tile, false);
+			InvalidateReservationCache(t->tile);
 			if (_settings_client.gui.show_track_reservation) MarkTileDirtyByTile(t->tile);
 
 			UpdateSignalsOnSegment(t->tile, INVALID_DIAGDIR, t->owner);
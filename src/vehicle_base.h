@@ -261,7 +261,24 @@ public:
 	friend class SlVehicleDisaster;
 	friend void Ptrs_VEHS();
 
+	/* The fields below are used by every vehicle tick and by the vehicle location hash lookups.
+	 * They are kept together so these only touch a few cache lines of each vehicle. */
 	TileIndex tile;                     ///< Current tile index
+	uint8_t vehstatus;                     ///< Status
+	uint8_t subtype;                       ///< subtype (Filled with values from #AircraftSubType/#DisasterSubType/#EffectVehicleType/#GroundVehicleSubtypeFlags)
+	Direction direction;                ///< facing
+	uint8_t progress;                      ///< The percentage (if divided by 256) this vehicle already crossed the tile unit.
+	Vehicle *hash_tile_next;            ///< NOSAVE: Next vehicle in the tile location hash.
+	int32_t x_pos;                        ///< x coordinate.
+	int32_t y_pos;                        ///< y coordinate.
+	int32_t z_pos;                        ///< z coordinate.
+	uint16_t cur_speed;                   ///< current speed
+	uint8_t subspeed;                      ///< fractional speed
+	uint8_t acceleration;                  ///< used by train & aircraft
+	uint32_t motion_counter;              ///< counter to occasionally play a vehicle sound.
+	uint16_t cargo_age_counter;           ///< Ticks till cargo is aged next.
+	uint8_t tick_counter;                  ///< Increased by one for each tick
+	VehicleCache vcache;                ///< Cache of often used vehicle values.
 
 	/**
 	 * Heading for this tile.
@@ -281,7 +298,6 @@ public:
 	Vehicle *hash_viewport_next;        ///< NOSAVE: Next vehicle in the visual location hash.
 	Vehicle **hash_viewport_prev;       ///< NOSAVE: Previous vehicle in the visual location hash.
 
-	Vehicle *hash_tile_next;            ///< NOSAVE: Next vehicle in the tile location hash.
 	Vehicle **hash_tile_prev;           ///< NOSAVE: Previous vehicle in the tile location hash.
 	Vehicle **hash_tile_current;        ///< NOSAVE: Cache of the current hash chain.
 
@@ -301,11 +317,6 @@ public:
 	uint8_t breakdowns_since_last_service; ///< Counter for the amount of breakdowns.
 	uint8_t breakdown_chance;              ///< Current chance of breakdowns.
 
-	int32_t x_pos;                        ///< x coordinate.
-	int32_t y_pos;                        ///< y coordinate.
-	int32_t z_pos;                        ///< z coordinate.
-	Direction direction;                ///< facing
-
 	Owner owner;                        ///< Which company owns the vehicle?
 	/**
 	 * currently displayed sprite index
@@ -325,12 +336,6 @@ public:
 	TextEffectID fill_percent_te_id;    ///< a text-effect id to a loading indicator object
 	UnitID unitnumber;                  ///< unit number, for display purposes only
 
-	uint16_t cur_speed;                   ///< current speed
-	uint8_t subspeed;                      ///< fractional speed
-	uint8_t acceleration;                  ///< used by train & aircraft
-	uint32_t motion_counter;              ///< counter to occasionally play a vehicle sound.
-	uint8_t progress;                      ///< The percentage (if divided by 256) this vehicle already crossed the tile unit.
-
 	uint8_t waiting_triggers;              ///< Triggers to be yet matched before rerandomizing the random bits.
 	uint16_t random_bits; ///< Bits used for randomized variational spritegroups.
 
@@ -343,16 +348,12 @@ public:
 	uint8_t cargo_subtype;                 ///< Used for livery refits (NewGRF variations)
 	uint16_t cargo_cap;                   ///< total capacity
 	uint16_t refit_cap;                   ///< Capacity left over from before last refit.
-	uint16_t cargo_age_counter;           ///< Ticks till cargo is aged next.
 	int8_t trip_occupancy;                ///< NOSAVE: Occupancy of vehicle of the current trip (updated after leaving a station).
 
 	uint8_t day_counter;                   ///< Increased by one for each day
-	uint8_t tick_counter;                  ///< Increased by one for each tick
 	uint8_t running_ticks;                 ///< Number of ticks this vehicle was not stopped this day
 	uint16_t load_unload_ticks;           ///< Ticks to wait before starting next cycle.
 
-	uint8_t vehstatus;                     ///< Status
-	uint8_t subtype;                       ///< subtype (Filled with values from #AircraftSubType/#DisasterSubType/#EffectVehicleType/#GroundVehicleSubtypeFlags)
 	Order current_order;                ///< The current order (+ status, like: loading)
 
 	union {
@@ -361,7 +362,6 @@ public:
 	};
 
 	NewGRFCache grf_cache;              ///< Cache of often used calculated NewGRF values
-	VehicleCache vcache;                ///< Cache of often used vehicle values.
 
 	GroupID group_id;                   ///< Index of group Pool array
 
@@ -50,6 +50,7 @@ uint8_t CalcPercentVehicleFilled(const Vehicle *v, StringID *colour);
 
 void VehicleLengthChanged(const Vehicle *u);
 
+void AllocateVehicleTileHash();
 void ResetVehicleHash();
 void ResetVehicleColourMap();
 
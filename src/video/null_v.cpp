@@ -12,6 +12,7 @@
 #include "../blitter/factory.hpp"
 #include "../saveload/saveload.h"
 #include "../window_func.h"
+#include "../framerate_type.h"
 #include "null_v.h"
 
 #include "../safeguards.h"
@@ -31,6 +32,7 @@ std::optional<std::string_view> VideoDriver_Null::Start(const StringList &parm)
 	this->UpdateAutoResolution();
 
 	this->ticks = GetDriverParamInt(parm, "ticks", 1000);
+	this->benchmark = GetDriverParamBool(parm, "benchmark");
 	_screen.width  = _screen.pitch = _cur_resolution.width;
 	_screen.height = _cur_resolution.height;
 	_screen.dst_ptr = nullptr;
@@ -56,6 +58,9 @@ void VideoDriver_Null::MainLoop()
 		::UpdateWindows();
 	}
 
+	/* In benchmark mode, report how fast the game loop ran. */
+	if (this->benchmark) PrintPerformanceReport();
+
 	/* If requested, make a save just before exit. The normal exit-flow is
 	 * not triggered from this driver, so we have to do this manually. */
 	if (_settings_client.gui.autosave_on_exit) {